@@ -0,0 +1,289 @@
+// Microbenchmarks of the game core hot paths, reports ns/op and allocations/op.
+// Usage: monke_bench [--max-words N] [--filter TEXT]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "alloc_counter.h"
+#include "dictionary.h"
+#include "game.h"
+
+namespace {
+
+// ---------- harness ----------
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+	double nsPerOp;
+	double allocsPerOp;
+};
+
+std::string filter;
+// allocations made inside timed sections
+long long timedAllocations = 0;
+// cost of the two clock reads around a timed section, taken off every timing
+long long clockOverheadNs = 0;
+
+auto enabled(const std::string &name) -> bool {
+	return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+auto report(const std::string &name, const std::string &param, const Result &result) -> void {
+	std::printf("%-28s %-22s %12.1f ns/op %10.3f allocs/op\n", name.c_str(), param.c_str(), result.nsPerOp, result.allocsPerOp);
+	std::fflush(stdout);
+}
+
+// Time one operation or a batch of them, their allocations are added to timedAllocations
+template <typename Fn>
+auto timed(Fn &&fn) -> long long {
+	const long long allocsBefore = static_cast<long long>(heapAllocations());
+	const auto start = Clock::now();
+	fn();
+	const auto end = Clock::now();
+	timedAllocations += static_cast<long long>(heapAllocations()) - allocsBefore;
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() - clockOverheadNs;
+}
+
+// Runs fn calls times, fn prepares opsPerCall operations untimed and returns timed() of them.
+// Batches keep the clock out of fast operations, one per call is left for operations that
+// need the state set up again before each of them.
+template <typename Fn>
+auto measure(const long long calls, const long long opsPerCall, Fn &&fn) -> Result {
+	timedAllocations = 0;
+	long long totalNs = 0;
+	for (long long i = 0; i < calls; ++i) {
+		totalNs += fn();
+	}
+	const auto ops = static_cast<double>(calls * opsPerCall);
+	return {static_cast<double>(totalNs) / ops, static_cast<double>(timedAllocations) / ops};
+}
+
+// Mean cost of timing nothing
+auto calibrateClock() -> void {
+	constexpr long long samples = 100'000;
+	long long totalNs = 0;
+	for (long long i = 0; i < samples; ++i) {
+		totalNs += timed([] {});
+	}
+	clockOverheadNs = totalNs / samples;
+}
+
+// ---------- fixtures ----------
+
+// Synthetic dictionary of random lowercase words, generated once per size
+auto dictionaryFile(const std::size_t words) -> std::string {
+	const auto path = std::filesystem::temp_directory_path() / ("monke_bench_" + std::to_string(words) + ".txt");
+	if (std::filesystem::exists(path)) {
+		return path.string();
+	}
+	std::mt19937 gen(static_cast<unsigned>(words));
+	std::uniform_int_distribution<int> length(3, 12);
+	std::uniform_int_distribution<int> letter('a', 'z');
+	std::ofstream out(path, std::ios::binary);
+	std::string word;
+	for (std::size_t i = 0; i < words; ++i) {
+		word.resize(static_cast<std::size_t>(length(gen)));
+		for (char &c : word) {
+			c = static_cast<char>(letter(gen));
+		}
+		out << word << '\n';
+	}
+	return path.string();
+}
+
+// Spawn until the target count is reached or spawning stops making progress
+auto fillActive(Game &game, const std::size_t target) -> void {
+	int stalled = 0;
+	while (game.activeWords.size() < target && stalled < 100) {
+		const std::size_t before = game.activeWords.size();
+		game.spawnWord();
+		stalled = game.activeWords.size() == before ? stalled + 1 : 0;
+	}
+}
+
+auto label(const std::size_t words, const std::size_t active) -> std::string {
+	return "dict=" + std::to_string(words) + " active=" + std::to_string(active);
+}
+
+// ---------- benchmarks ----------
+
+auto benchLoad(const std::size_t words, const std::string &path) -> void {
+	if (!enabled("loadWordsFromFile")) {
+		return;
+	}
+	const long long ops = std::max<long long>(3, static_cast<long long>(2'000'000 / words));
+	const Result result = measure(ops, 1, [&] {
+		Dictionary dictionary;
+		return timed([&] { dictionary.loadFromFile(path); });
+	});
+	report("loadWordsFromFile", "dict=" + std::to_string(words), result);
+}
+
+auto benchSpawn(Game &game, const std::size_t words, const std::size_t active) -> void {
+	if (!enabled("spawnWord")) {
+		return;
+	}
+	game.reset();
+	fillActive(game, active);
+	const std::size_t reached = game.activeWords.size();
+	// a batch kills words and spawns their replacements, only the spawns are timed
+	const std::size_t batch = std::clamp<std::size_t>(reached, 1, 64);
+	const Result result = measure(20'000, static_cast<long long>(batch), [&] {
+		for (std::size_t i = 0; i < batch; ++i) {
+			game.submitWord(game.activeWords.text[i]);
+		}
+		game.tick(0.f);
+		return timed([&] {
+			for (std::size_t i = 0; i < batch; ++i) {
+				game.spawnWord();
+			}
+		});
+	});
+	report("spawnWord", label(words, reached), result);
+}
+
+auto benchCheck(Game &game, const std::size_t words, const std::size_t active) -> void {
+	if (!enabled("checkWordOnScreen")) {
+		return;
+	}
+	game.reset();
+	fillActive(game, active);
+	const std::size_t reached = game.activeWords.size();
+	std::size_t next = 0;
+	// alternate hits and misses, the word is typed untimed
+	const Result result = measure(20'000, 1, [&] {
+		const bool hit = next++ % 2 == 0;
+		const std::u32string_view word = game.activeWords.text[next % game.activeWords.size()];
+		for (const char32_t c : word) {
+			game.typeChar(c);
+		}
+		if (!hit) {
+			game.typeChar(U'#');
+		}
+		const long long ns = timed([&] { game.checkWordOnScreen(); });
+		if (hit) {
+			game.tick(0.f);
+			game.spawnWord();
+		}
+		return ns;
+	});
+	report("checkWordOnScreen", label(words, reached), result);
+}
+
+// Enter without an exact match, every living word is compared to the input
+auto benchTypoCheck(Game &game, const std::size_t words, const std::size_t active) -> void {
+	if (!enabled("checkWordOnScreen typo")) {
+		return;
+	}
+	game.reset();
+	fillActive(game, active);
+	const std::size_t reached = game.activeWords.size();
+	std::size_t next = 0;
+	// the middle letter of the word is mistyped, the word is typed untimed
+	const Result result = measure(20'000, 1, [&] {
+		const std::u32string_view word = game.activeWords.text[next++ % game.activeWords.size()];
+		for (std::size_t i = 0; i < word.size(); ++i) {
+			game.typeChar(i == word.size() / 2 ? U'#' : word[i]);
+		}
+		const long long ns = timed([&] { game.checkWordOnScreen(); });
+		game.tick(0.f);
+		game.spawnWord();
+		return ns;
+	});
+	report("checkWordOnScreen typo", label(words, reached), result);
+}
+
+auto benchFonts(Game &game) -> void {
+	if (!enabled("getNextFontIndex")) {
+		return;
+	}
+	game.reset();
+	constexpr long long batch = 1'000;
+	const Result result = measure(1'000, batch, [&] {
+		return timed([&] {
+			for (long long i = 0; i < batch; ++i) {
+				game.releaseFont(game.getNextFontIndex());
+			}
+		});
+	});
+	report("getNextFontIndex+release", "", result);
+}
+
+auto benchRecycle(Game &game, const std::size_t words, const std::size_t active) -> void {
+	if (!enabled("recycle")) {
+		return;
+	}
+	game.reset();
+	fillActive(game, active);
+	const std::size_t reached = game.activeWords.size();
+	long long recycled = 0;
+	long long totalNs = 0;
+	timedAllocations = 0;
+	// kill every word on screen, time the tick that recycles them
+	for (int round = 0; round < 200; ++round) {
+		for (std::size_t i = 0; i < game.activeWords.size(); ++i) {
+			game.submitWord(game.activeWords.text[i]);
+		}
+		recycled += static_cast<long long>(game.activeWords.size());
+		totalNs += timed([&] { game.tick(0.f); });
+		fillActive(game, active);
+	}
+	report("recycle (per word)", label(words, reached),
+		   {static_cast<double>(totalNs) / static_cast<double>(recycled), static_cast<double>(timedAllocations) / static_cast<double>(recycled)});
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	std::size_t maxWords = 10'000'000;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		const std::string arg = argv[i];
+		if (arg == "--max-words") {
+			maxWords = std::stoull(argv[i + 1]);
+		} else if (arg == "--filter") {
+			filter = argv[i + 1];
+		}
+	}
+
+	calibrateClock();
+	std::printf("clock overhead %lld ns, taken off every timing\n", clockOverheadNs);
+
+	constexpr std::size_t dictionarySizes[] = {100, 10'000, 1'000'000, 10'000'000};
+	constexpr std::size_t activeCounts[] = {16, 1'000, 100'000};
+	for (const std::size_t words : dictionarySizes) {
+		if (words > maxWords) {
+			break;
+		}
+		const std::string path = dictionaryFile(words);
+		benchLoad(words, path);
+
+		if (words == 100) {
+			Game game(path, 15, 1280.f);
+			benchFonts(game);
+		}
+		for (const std::size_t active : activeCounts) {
+			if (active > words) {
+				break;
+			}
+			// stress limits with every word unique and a lane per word,
+			// the benchmarks never advance time so lanes would not free up
+			GameLimits limits = GameLimits::stress(active, 15);
+			limits.repeatWords = false;
+			limits.laneHeight = 450.f / static_cast<float>(active);
+			Game game(path, 15, 1280.f, limits);
+			benchSpawn(game, words, active);
+			benchCheck(game, words, active);
+			benchRecycle(game, words, active);
+
+			limits.typoTolerance = 2;
+			Game typoGame(game.dictionary, 15, 1280.f, limits);
+			benchTypoCheck(typoGame, words, active);
+		}
+	}
+	return 0;
+}
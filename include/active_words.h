@@ -0,0 +1,82 @@
+#ifndef ACTIVE_WORDS_H
+#define ACTIVE_WORDS_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "word_handle.h"
+
+// color band of a word, depends on how far it travelled across the screen
+enum class ColorBand : std::uint8_t { Green, Yellow, Red };
+
+// Words on the screen stored as parallel arrays, one entry per slot.
+// Movement and banding only touch the arrays they need, so they run as
+// straight loops over floats that the kernels process four at a time.
+// Slots are dense, the last word moves into the slot of a removed one, so
+// slot order is not spawn order and everything outside the store refers to
+// words by handle. Storage is allocated once
+// for a fixed number of words, adding and removing never allocates.
+class ActiveWords {
+public:
+	static constexpr std::size_t npos = SIZE_MAX;
+
+	// room for capacity words
+	explicit ActiveWords(std::size_t capacity);
+
+	// append a word, returns its slot, the store must not be full
+	auto add(std::u32string_view word, std::uint32_t id, int font, float startX, float startY, float speed, int spawnLane) -> std::size_t;
+	// mark the word dead, it is dropped by the next removeDead
+	auto kill(std::size_t slot) -> void;
+	// slots killed since the last removeDead
+	auto dead() const -> const std::vector<std::size_t>&;
+	// drop dead words, survivors keep their handles
+	auto removeDead() -> void;
+	auto clear() -> void;
+
+	// slot of the word, npos when the word is gone
+	auto resolve(WordHandle handle) const -> std::size_t;
+
+	// remember the current positions and move every word by speed * dt
+	auto integrate(float dt) -> void;
+	// band of every word by its x
+	auto classify(float yellowX, float redX) -> void;
+	// x blended between the last two ticks
+	auto interpolatedX(std::size_t slot, float alpha) const -> float;
+
+	auto size() const -> std::size_t;
+	auto empty() const -> bool;
+	auto full() const -> bool;
+	auto capacity() const -> std::size_t;
+
+	// hot, touched every tick
+	std::vector<float> x;
+	std::vector<float> prevX; // x before the last tick, for interpolated drawing
+	std::vector<float> speedX;
+	std::vector<ColorBand> band;
+	std::vector<std::uint8_t> alive;
+
+	// cold, touched on spawn, input and drawing
+	std::vector<float> y;
+	std::vector<std::u32string_view> text; // views into the dictionary
+	std::vector<std::uint32_t> wordId;
+	std::vector<int> fontIndex;
+	std::vector<int> indexNode; // terminal node in the word index
+	std::vector<int> lane;      // spawn lane
+	std::vector<WordHandle> handle;
+
+private:
+	// copy the word in slot from into slot to
+	auto move(std::size_t from, std::size_t to) -> void;
+	// hand the handle entry back, its next owner gets a new generation
+	auto releaseHandle(WordHandle released) -> void;
+
+	std::size_t maxWords;
+	std::vector<std::uint32_t> handleSlot;       // slot of every handle entry
+	std::vector<std::uint32_t> handleGeneration; // current generation of every handle entry
+	std::vector<std::uint32_t> freeHandles;      // unused handle entries
+	std::vector<std::size_t> deadSlots;
+};
+
+#endif // ACTIVE_WORDS_H
@@ -0,0 +1,13 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+#pragma once
+
+#include <cstdint>
+
+// Number of global operator new calls since the program started.
+// Linking this replaces the global operator new and delete with counting
+// versions, it only gets linked when something asks for the count, which
+// is the profiler in debug builds and the benchmarks.
+auto heapAllocations() -> std::uint64_t;
+
+#endif // ALLOC_COUNTER_H
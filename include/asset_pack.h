@@ -0,0 +1,51 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "mapped_file.h"
+
+// All game assets in one indexed file, memory mapped as a whole and never
+// copied, resources are loaded straight from the mapping.
+// Layout, integers little endian:
+//   "MONKEPAK", u32 version, u32 file count
+//   per file: u64 offset, u64 size, u32 name length, name
+//   file contents at their offsets, 16 byte aligned
+// Names are paths relative to the assets directory with '/' separators.
+class AssetPack {
+public:
+	// map the pack and read its index, returns false when it is missing or broken
+	auto open(const std::string& path) -> bool;
+	auto isOpen() const -> bool;
+
+	// contents of the file, nullopt when the pack does not have it
+	auto find(std::string_view name) const -> std::optional<std::string_view>;
+	// names of all files, sorted
+	auto names() const -> std::vector<std::string_view>;
+
+	// write files given as name and contents into a new pack
+	static auto write(const std::string& path, std::vector<std::pair<std::string, std::string>> files) -> bool;
+
+private:
+	struct Entry {
+		std::string_view name; // points into the mapping
+		std::string_view data;
+	};
+
+	MappedFile file;
+	std::vector<Entry> entries; // sorted by name
+};
+
+// directory of the running executable, the current directory if it cannot be found
+auto executableDirectory() -> std::filesystem::path;
+
+// names of the font files the game ships, from the pack when it is open, else from assetsDir
+auto fontAssetNames(const AssetPack& pack, const std::filesystem::path& assetsDir) -> std::vector<std::string>;
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,84 @@
+#ifndef ASSET_REGISTRY_H
+#define ASSET_REGISTRY_H
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "asset_pack.h"
+#include "font.h"
+#include "mapped_file.h"
+
+// handle of a font in the registry, same as the font index used by Game
+using FontHandle = int;
+
+// Central place owning the game assets. Asset bytes come from the asset pack
+// when there is one, otherwise every file of the assets directory is memory
+// mapped on first use. Fonts are discovered from the fonts directory and every
+// font is parsed exactly once, either lazily on first use or by background
+// workers. References and views handed out stay valid for the registry lifetime.
+class AssetRegistry {
+public:
+	// constructor, assets are read from the pack if it opens, else from assetsDir
+	AssetRegistry(std::string assetsDir, const std::string& packPath);
+	// destructor, waits for background loading
+	~AssetRegistry();
+
+	AssetRegistry(const AssetRegistry&) = delete;
+	auto operator=(const AssetRegistry&) -> AssetRegistry& = delete;
+
+	// contents of an asset relative to the assets directory, empty when it is missing
+	auto bytes(const std::string& relative) -> std::string_view;
+
+	// find all .ttf files in the fonts directory, nothing is loaded yet
+	auto discoverFonts() -> void;
+	// start loading all discovered fonts on a pool of worker threads
+	auto loadFontsAsync(unsigned threadCount = std::thread::hardware_concurrency()) -> void;
+
+	// handle of the font with the given name, -1 when there is no such font
+	auto fontHandle(const std::string& name) const -> FontHandle;
+	// font for the handle, loads it on the calling thread if nobody did yet
+	auto font(FontHandle handle) -> Font&;
+	// number of discovered fonts
+	auto fontCount() const -> int;
+	// number of fonts already loaded (or failed to)
+	auto loadedFontCount() const -> int;
+
+	// rasterize glyphs of the characters into the font atlas ahead of time,
+	// must be called on a thread with an active OpenGL context
+	auto prewarmGlyphs(FontHandle handle, const std::u32string& characters, unsigned characterSize) -> void;
+
+	// full path of an asset relative to the assets directory
+	auto path(const std::string& relative) const -> std::string;
+
+private:
+	struct FontSlot {
+		Font font;
+		std::once_flag once;
+		bool ok = false;
+
+		std::string relative; // asset name of the font file
+
+		FontSlot(std::string name, std::string relative, std::string fontPath)
+			: font(std::move(name), std::move(fontPath)), relative(std::move(relative)) {}
+	};
+
+	// load font exactly once, whichever thread comes first
+	auto ensureLoaded(FontHandle handle) -> FontSlot&;
+
+	std::string assetsDir;
+	AssetPack pack;
+	std::mutex looseMutex;            // font workers map loose files too
+	std::deque<MappedFile> looseFiles; // mapped files of the assets directory
+	std::vector<std::unique_ptr<FontSlot>> fonts;
+	std::atomic<int> loadedFonts{0};
+	std::atomic<int> nextToLoad{0};
+	std::vector<std::jthread> workers;
+};
+
+#endif // ASSET_REGISTRY_H
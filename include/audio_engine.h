@@ -0,0 +1,59 @@
+#ifndef AUDIO_ENGINE_H
+#define AUDIO_ENGINE_H
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// handle of a decoded sound effect
+using SoundHandle = int;
+
+// Sound effects are decoded into memory once and played on a fixed pool of
+// voices. Voices are used round robin, so a new sound takes the voice that
+// started playing longest ago and fast typing never cuts off the last click.
+// Music is either streamed from disk or decoded whole and looped from memory.
+class AudioEngine {
+public:
+	// constructor, voiceCount sounds can play at once
+	explicit AudioEngine(std::size_t voiceCount = 16);
+	// destructor, stops everything before the buffers go away
+	~AudioEngine();
+
+	AudioEngine(const AudioEngine&) = delete;
+	auto operator=(const AudioEngine&) -> AudioEngine& = delete;
+
+	// decode a short effect from encoded file contents, returns -1 when it cannot be loaded
+	auto loadEffect(const std::string& name, std::string_view data) -> SoundHandle;
+	// play the effect, steals the oldest voice when all are busy
+	auto play(SoundHandle sound) -> void;
+	// volume of all effects, 0 to 100
+	auto setEffectsVolume(float volume) -> void;
+
+	// open the music loop from encoded file contents, which have to outlive the
+	// engine when streamed, inMemory decodes it whole for gapless looping
+	auto loadMusic(const std::string& name, std::string_view data, bool inMemory) -> bool;
+	auto playMusic() -> void;
+	auto stopMusic() -> void;
+	auto isMusicPlaying() const -> bool;
+	// music volume, 0 to 100
+	auto setMusicVolume(float volume) -> void;
+	auto musicVolume() const -> float;
+
+private:
+	std::deque<sf::SoundBuffer> effects; // deque, voices point into it
+	std::vector<sf::Sound> voices;
+	std::vector<SoundHandle> voiceEffect; // effect bound to every voice
+	std::size_t nextVoice = 0;
+
+	sf::Music musicStream;
+	sf::SoundBuffer musicBuffer;
+	sf::Sound musicVoice;
+	bool musicInMemory = false;
+	bool musicLoaded = false;
+};
+
+#endif // AUDIO_ENGINE_H
@@ -0,0 +1,48 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// 64 bit FNV-1a, cheap and good enough to tell two game states or word lists apart
+class Checksum {
+public:
+	auto add(const std::string_view bytes) -> void {
+		for (const char c : bytes) {
+			hash = (hash ^ static_cast<unsigned char>(c)) * prime;
+		}
+	}
+	auto add(const std::u32string_view text) -> void {
+		for (const char32_t c : text) {
+			add(static_cast<std::uint32_t>(c));
+		}
+	}
+	// numbers are hashed by value, little end first, so the hash does not depend on the host
+	template <typename T>
+		requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+	auto add(const T value) -> void {
+		std::uint64_t bits = 0;
+		if constexpr (std::is_floating_point_v<T>) {
+			bits = sizeof(T) == 4 ? std::bit_cast<std::uint32_t>(static_cast<float>(value)) : std::bit_cast<std::uint64_t>(static_cast<double>(value));
+		} else {
+			bits = static_cast<std::uint64_t>(value);
+		}
+		for (std::size_t i = 0; i < sizeof(T); ++i) {
+			hash = (hash ^ (bits & 0xff)) * prime;
+			bits >>= 8;
+		}
+	}
+
+	auto value() const -> std::uint64_t {
+		return hash;
+	}
+
+private:
+	static constexpr std::uint64_t prime = 0x100000001b3ull;
+	std::uint64_t hash = 0xcbf29ce484222325ull;
+};
+
+#endif // CHECKSUM_H
@@ -0,0 +1,63 @@
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Word list read from a UTF-8 file or from memory, like an asset pack. Every
+// word is decoded and composed once while loading into one code point arena,
+// only the offset and length of a word are kept besides it.
+// A line may carry a frequency after a tab, "word\t120".
+class Dictionary {
+public:
+	// map the file and split it into words, returns false when it cannot be opened
+	auto loadFromFile(const std::string& filePath) -> bool;
+	// split UTF-8 text, returns false when it is too large
+	auto loadFromMemory(std::string_view bytes) -> bool;
+
+	// number of words
+	auto size() const -> std::size_t;
+	auto empty() const -> bool;
+	// word with the given id
+	auto operator[](std::uint32_t id) const -> std::u32string_view;
+
+	// frequency of the word, 1 when the file has no frequency column
+	auto hasFrequencies() const -> bool;
+	auto frequency(std::uint32_t id) const -> float;
+
+	// length of the longest word in code points
+	auto longestWord() const -> std::size_t;
+
+	// distinct code points used by the words, sorted
+	auto charset() const -> const std::u32string&;
+
+	// hash of all words in order, tells apart dictionaries a recording can not be replayed with
+	auto checksum() const -> std::uint64_t;
+
+	// number of lines rejected while loading
+	auto rejectedLines() const -> std::size_t;
+
+private:
+	// forget loaded words
+	auto clear() -> void;
+	// split text into lines, skipping empty and invalid ones
+	auto split(std::string_view bytes) -> void;
+
+	struct Entry {
+		std::uint32_t offset;
+		std::uint32_t length;
+	};
+
+	std::u32string text; // all words back to back, the entry offsets point into it
+	std::vector<Entry> entries;
+	std::vector<float> frequencies; // empty when no line has a frequency
+	std::u32string characters; // sorted distinct code points
+	std::size_t longest = 0;
+	std::size_t rejected = 0;
+};
+
+#endif // DICTIONARY_H
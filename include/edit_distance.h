@@ -0,0 +1,37 @@
+#ifndef EDIT_DISTANCE_H
+#define EDIT_DISTANCE_H
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Levenshtein distance of one pattern against many texts with Myers' bit-vector
+// algorithm in Hyyrö's formulation. A column of the dynamic programming matrix
+// is held as bits of one 64 bit word, so comparing a text of n characters costs
+// n steps of a dozen bit operations however long the pattern is. The pattern
+// is prepared once and compared without allocating.
+class EditDistance {
+public:
+	// longest pattern that fits a single machine word
+	static constexpr std::size_t maxPattern = 64;
+
+	// pattern the texts are compared to, false when it is empty or too long
+	auto setPattern(std::u32string_view pattern) -> bool;
+	// edits turning the pattern into text, limit + 1 as soon as it must be more than limit
+	auto distance(std::u32string_view text, int limit) const -> int;
+
+private:
+	// bit i set when pattern character i is c
+	auto mask(char32_t c) const -> std::uint64_t;
+
+	std::size_t length = 0;
+	std::array<std::uint64_t, 128> asciiMasks{};
+	// distinct non ASCII characters of the pattern and their masks
+	std::array<char32_t, maxPattern> otherChars{};
+	std::array<std::uint64_t, maxPattern> otherMasks{};
+	std::size_t otherCount = 0;
+};
+
+#endif // EDIT_DISTANCE_H
@@ -4,6 +4,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <string_view>
 
 // Font class
 class  Font {
@@ -15,8 +16,8 @@ public:
 	// constructor
     Font(std::string name, std::string fontPath);
 
-	// public functions
-    bool load();
+	// public functions, data has to outlive the font
+    bool load(std::string_view data);
     sf::Font& getSfFont() ;
 };
 
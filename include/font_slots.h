@@ -0,0 +1,39 @@
+#ifndef FONT_SLOTS_H
+#define FONT_SLOTS_H
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Hands out fonts to spawned words, every font can be used by at most quota
+// words at once. Fonts that still have room are kept in a bitset and taken
+// round robin, finding the next one is a count of trailing zeros per 64 fonts.
+class FontSlots {
+public:
+	// count fonts, each usable quota times at once
+	FontSlots(int count, int quota);
+
+	// next font with room left after the last one taken, -1 when all are full
+	auto take() -> int;
+	// word using the font is gone
+	auto release(int font) -> void;
+	// give back all fonts
+	auto reset() -> void;
+
+	auto uses(int font) const -> int;
+	// number of fonts
+	auto size() const -> int;
+
+private:
+	auto setAvailable(int font, bool available) -> void;
+	// first available font at or after font, -1 when there is none
+	auto findFrom(int font) const -> int;
+
+	int count;
+	int quota;
+	int cursor = 0; // where the next search starts
+	std::vector<int> usage;
+	std::vector<std::uint64_t> available; // bit per font with room left
+};
+
+#endif // FONT_SLOTS_H
@@ -0,0 +1,42 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+#pragma once
+
+#include <cstdint>
+
+// Decides when the window draws the next frame. While something moves, frames
+// are drawn at the frame rate. On still screens a frame is drawn only after
+// input or when a deadline asked for by a blink or animation step passed, and
+// the loop sleeps in between instead of redrawing the same picture.
+// What a frame asks for applies to the frame after it.
+class FrameScheduler {
+public:
+	// constructor, frames are never drawn faster than frameRate
+	explicit FrameScheduler(int frameRate);
+
+	// a frame is drawn now, requests of the previous frame are used up
+	auto beginFrame(std::int64_t nowNs) -> void;
+	// the screen changes every frame, like gameplay or a loading bar
+	auto animate() -> void;
+	// the screen has to be redrawn, like after input
+	auto invalidate() -> void;
+	// draw again no later than atNs, like the next blink toggle
+	auto wakeAt(std::int64_t atNs) -> void;
+
+	// true when the next frame is due
+	auto due(std::int64_t nowNs) const -> bool;
+	// how long to sleep before polling events again, short while animating so
+	// key presses are still timestamped when they arrive
+	auto sleepNs(std::int64_t nowNs) const -> std::int64_t;
+	// true when nothing asked for the next frame but a deadline
+	auto idle() const -> bool;
+
+private:
+	std::int64_t frameNs;
+	std::int64_t lastFrameNs = 0;
+	std::int64_t deadlineNs;
+	bool animating = false;
+	bool dirty = true; // the first frame is always drawn
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,52 @@
+#ifndef FRAME_SNAPSHOT_H
+#define FRAME_SNAPSHOT_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "active_words.h"
+
+class Game;
+
+// Everything the renderer needs of one simulated state, copied out of Game so
+// the render thread never reads Game itself. Storage is reserved once and
+// reused, capturing a snapshot does not allocate.
+struct FrameSnapshot {
+	// living words, text points into the dictionary which never changes
+	std::vector<float> x;
+	std::vector<float> prevX; // x one tick earlier, for interpolation
+	std::vector<float> y;
+	std::vector<ColorBand> band;
+	std::vector<int> fontIndex;
+	std::vector<std::u32string_view> text;
+	std::vector<std::size_t> matched; // length of the typed prefix to highlight
+
+	// HUD values
+	std::u32string input;
+	int score = 0;
+	int lives = 0;
+	int wpm = 0;
+	int accuracy = 0;
+
+	// round the snapshot belongs to, over once that round ended
+	std::uint32_t round = 0;
+	bool over = false;
+	// steady clock time of the latest tick and the tick length, for interpolation
+	std::int64_t tickNs = 0;
+	float tickDuration = 0.f;
+
+	// room for that many living words
+	auto reserve(std::size_t words) -> void;
+	// copy the state of game, latest tick taken at tickNs
+	auto capture(Game& game, std::int64_t tickNs, float tickDuration) -> void;
+	auto size() const -> std::size_t;
+	// how far between the previous and the latest tick nowNs is, 0..1
+	auto alpha(std::int64_t nowNs) const -> float;
+	// x of word i blended between the last two ticks
+	auto interpolatedX(std::size_t i, float alpha) const -> float;
+};
+
+#endif // FRAME_SNAPSHOT_H
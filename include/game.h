@@ -2,81 +2,129 @@
 #define GAME_H
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <deque>
-#include "font.h"
+#include "active_words.h"
+#include "dictionary.h"
+#include "edit_distance.h"
+#include "font_slots.h"
+#include "input.h"
+#include "lane_allocator.h"
+#include "rng.h"
+#include "typing_stats.h"
+#include "word_index.h"
+#include "word_pool.h"
 
+// caps on how much can go on at once, the defaults are the normal game
+struct GameLimits {
+	std::size_t maxActiveWords = 16; // words on the screen at most
+	float spawnInterval = 1.5f;      // seconds between spawns
+	int fontQuota = 7;               // words drawn with the same font at once
+	float laneHeight = 15.f;         // vertical distance between spawn lanes
+	bool keepWordsApart = true;      // false lets faster words run over slower ones
+	bool repeatWords = false;        // a word may be on the screen more than once
+	bool endless = false;            // running out of lives does not end the round
+	int typoTolerance = 0;           // edits Enter forgives when no word matches exactly, 0 takes exact words only
 
+	// endurance run with thousands of words, for burn-in and renderer profiling
+	static auto stress(std::size_t maxWords, int fontCount) -> GameLimits;
+};
 
+// Game holds all game rules and state, it knows nothing about rendering
+// and is advanced with an explicit dt, so it can run without a window
 class Game {
 public:
 	// explicit constructor
-	explicit Game(const std::string& wordsFilePath);
-
-	// game word struct
-	struct GameWord {
-		std::string originalString;
-		sf::Text sfText;
-		bool isAlive;
-		int fontIndex;
-		float speedX;
-
-		// default constructor
-		GameWord()
-			: isAlive(false),
-			  fontIndex(-1),
-			  speedX(0.f) {}
-
-		// custom constructor
-		GameWord(const std::string& word,
-				 const sf::Font& font, const int fontIndex, const float speed)
-				:originalString(word),
-				 isAlive(true),
-				 fontIndex(fontIndex),
-				 speedX(speed)
-		{
-			// text settings
-			sfText.setString(word);
-			sfText.setFont(font);
-			sfText.setCharacterSize(20);
-			sfText.setFillColor(sf::Color::Green);
-		}
-		// update function
-		auto update(float dt)-> void;
-	};
+	Game(const std::string& wordsFilePath, int fontCount, float worldWidth, const GameLimits& limits = {});
+	// words already loaded, from an asset pack for example
+	Game(Dictionary words, int fontCount, float worldWidth, const GameLimits& limits = {});
 
 	// return next font index
 	auto getNextFontIndex() -> int;
 
 	// freeing the font
 	auto releaseFont(int fontIndex) -> void;
+	// number of fonts words are drawn with
+	auto fontCount() const -> int;
 
-	// access to font
-	auto getFont(int index) -> Font&;
+	// checking typed input against words on screen, returns number of destroyed words,
+	// a word scores one point, with typos forgiven an exact word scores two and a forgiven one scores one
+	auto checkWordOnScreen() -> int;
 
-	// loading words from file
-	static auto loadWordsFromFile(const std::string &filePath) -> std::vector<std::string>;
-	// loading all fonts from folder
-	static auto loadAllFonts() -> std::vector<Font>;
-	// checking word on screen
-	static auto checkWordOnScreen(const std::string& typedWord, std::vector<GameWord>& activeWords, Game &game) -> void;
+	// typing handling
+	auto applyInput(const InputEvent& event) -> void;
+	auto typeChar(char32_t c) -> void;
+	auto eraseChar() -> void;
+	auto getPlayerInput() const -> const std::u32string&;
+	// number of words on screen starting with the typed input
+	auto candidateCount() const -> int;
+	// length of the typed prefix to highlight in the word in slot
+	auto matchedLength(std::size_t slot) const -> std::size_t;
 
 	// initialize inactive words
 	auto initInactiveWords() -> void;
-	// word spawn
-	auto spawnWord() -> void;
+	// word spawn, false when no word, font or free lane was available
+	auto spawnWord() -> bool;
+	// how likely words are to be picked for spawning
+	auto setWordWeighting(WordWeighting weighting) -> void;
+
+	// reset score, lives and words for a new round
+	auto reset() -> void;
+	// new round whose spawns depend only on the seed and the input, for recording and replay
+	auto reset(std::uint32_t seed) -> void;
+	// advance the simulation by dt seconds
+	auto tick(float dt) -> void;
+	// type the whole word and press enter, returns number of words it destroyed
+	auto submitWord(std::u32string_view typedWord) -> int;
+	// true when player has no lives left, never in endless games
+	auto isOver() const -> bool;
+	// hash of score, lives, input and every word on the screen, equal for equal rounds
+	auto stateChecksum() const -> std::uint64_t;
+
+	Dictionary dictionary;                  // all words
+	WordPool inActiveWords;                 // ids of words ready to be spawned
+	ActiveWords activeWords;                // words on the screen
 
-	std::vector<std::string> words;      // all words
-	std::deque<GameWord> inActiveWords;  // words ready to be spawned
-	std::vector<GameWord> activeWords;  // words on the screen
+	// player resources and score
+	int score = 0;
+	int lives = 6;
+
+	// typing speed and accuracy of the current round
+	TypingStats stats;
+
+	// width of the playfield, words leaving it cost a life
+	float worldWidth;
+	// caps the game was created with
+	const GameLimits limits;
 
 private:
-	// fonts
-	std::vector<Font> fonts;
-	// counter for font usage
-	std::vector<int> fontUsageCount;
-	// font index
-	int currentFontIndex;
+	// mark word as dead and remove it from the index
+	auto killWord(std::size_t slot) -> void;
+	// kill the living word closest to the typed input within the typo tolerance
+	auto killClosestWord() -> bool;
+	// parts of tick
+	auto updateWords(float dt) -> void;
+	auto recycleWords() -> void;
+
+	// index of words on screen narrowed by typed input
+	WordIndex index;
+	// typed input prepared for comparing against every word on the screen
+	EditDistance typoMatcher;
+	// last typed grapheme while it is composed, kept to reuse its storage
+	std::u32string typedGrapheme;
+	// working storage of composing it
+	std::u32string composeScratch;
+	// fonts words can be drawn with
+	FontSlots fonts;
+	// time since last spawn
+	float spawnTimer = 0.f;
+	// free spots at the spawn edge
+	LaneAllocator lanes;
+	// how fast a word spawned into a lane can reach the right edge
+	float followerTime = 0.f;
+	// random generator for spawning, the only source of randomness of a round
+	RandomEngine gen;
 };
 #endif // GAME_H
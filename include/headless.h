@@ -0,0 +1,54 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "asset_pack.h"
+#include "game.h"
+#include "word_pool.h"
+
+// caps given on the command line, shared by the headless run and the window
+struct LimitOptions {
+	bool stress = false;            // endurance limits instead of the normal game
+	std::size_t maxWords = 0;       // overrides of the limits, 0 keeps the mode default
+	float spawnInterval = 0.f;
+	int fontQuota = 0;
+	int typoTolerance = 0;          // edits forgiven on Enter, 0 takes exact words only
+};
+
+// options of the headless simulation run
+struct HeadlessOptions {
+	std::string wordsFilePath;      // empty reads words from the assets next to the executable
+	long long ticks = 10'000'000;   // number of simulation ticks to run
+	float dt = 1.f / 60.f;          // simulated time per tick
+	int fontCount = 0;              // fonts words are drawn with, 0 counts the fonts shipped with the game
+	int typeEvery = 45;             // ticks between words typed by the bot, 0 disables typing
+	float worldWidth = 1280.f;
+	WordWeighting weighting = WordWeighting::Uniform;
+	LimitOptions limits;
+	std::optional<std::uint32_t> seed; // spawn seed of the first round, random when not given
+	std::string replayPath;         // replay this recording instead of running the bot
+};
+
+// read "--max-words", "--spawn-interval", "--font-quota" or "--typos" with its value,
+// false when arg is none of them, throws std::exception on a bad value
+auto parseLimitOption(const std::string& arg, const std::string& value, LimitOptions& options) -> bool;
+// game limits of the mode with the overrides applied, stress quotas depend on the font count
+auto resolveLimits(const LimitOptions& options, int fontCount) -> GameLimits;
+// fonts the window draws with, found the way the asset registry finds them, pack is opened when it is not yet
+auto shippedFontCount(AssetPack& pack) -> int;
+
+// parse command line arguments into headless options, returns false on bad arguments
+auto parseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options) -> bool;
+
+// run the game simulation without a window as fast as the CPU allows
+auto runHeadless(const HeadlessOptions& options) -> int;
+
+// play a recorded round back as fast as possible and compare its final state,
+// returns 0 when the replay ended in the recorded state
+auto runReplay(const HeadlessOptions& options) -> int;
+
+#endif // HEADLESS_H
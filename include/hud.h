@@ -0,0 +1,64 @@
+#ifndef HUD_H
+#define HUD_H
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// Text showing "<label><number>", rebuilt only when the number changes
+class HudCounter {
+public:
+	// constructor
+	HudCounter(std::string label, const sf::Font& font, unsigned characterSize, sf::Vector2f position);
+
+	auto set(int newValue) -> void;
+	auto draw(sf::RenderTarget& target) const -> void;
+
+private:
+	std::string label;
+	std::string buffer; // reused for formatting
+	sf::Text text;
+	int value;
+	bool hasValue = false;
+};
+
+// Retained HUD. Static shortcut instructions are composited once into a render
+// texture and drawn as a single sprite, dynamic texts keep their geometry until
+// the value they show changes.
+class Hud {
+public:
+	// constructor
+	Hud(const sf::Font& font, sf::Vector2u size);
+
+	// dynamic elements, cheap to call every frame
+	auto setScore(int score) -> void;
+	auto setLives(int lives) -> void;
+	auto setWpm(int wpm) -> void;
+	auto setAccuracy(int percent) -> void;
+	auto setInput(const std::u32string& input) -> void;
+
+	// shortcut instructions, shown in every phase
+	auto drawShortcuts(sf::RenderTarget& target) const -> void;
+	// score, lives and player input, shown while playing
+	auto drawPlaying(sf::RenderTarget& target) const -> void;
+
+private:
+	// draw shortcut texts into the overlay texture
+	auto composeOverlay() -> void;
+
+	sf::Vector2u size;
+	std::vector<sf::Text> shortcuts;
+	sf::RenderTexture overlay;
+	sf::Sprite overlaySprite;
+	bool overlayReady = false;
+
+	HudCounter scoreCounter;
+	HudCounter livesCounter;
+	HudCounter wpmCounter;
+	HudCounter accuracyCounter;
+	sf::Text inputText;
+	std::u32string input; // input currently shown
+};
+
+#endif // HUD_H
@@ -0,0 +1,42 @@
+#ifndef INPUT_H
+#define INPUT_H
+#pragma once
+
+#include <cstdint>
+#include "spsc_ring.h"
+
+class Game;
+class SessionRecorder;
+
+// typing event with the time it was pulled from the window
+struct InputEvent {
+	enum class Type : std::uint8_t { Char, Backspace, Enter };
+
+	Type type = Type::Char;
+	char32_t character = 0; // code point
+	std::int64_t timestampNs = 0; // steady clock
+};
+
+// events travel from the event pump to the simulation through this ring
+using InputQueue = SpscRing<InputEvent, 1024>;
+
+// time between an event being pulled and the simulation applying it
+struct InputLatency {
+	std::int64_t count = 0;
+	std::int64_t totalNs = 0;
+	std::int64_t maxNs = 0;
+
+	auto record(std::int64_t latencyNs) -> void;
+	auto meanMs() const -> double;
+	auto maxMs() const -> double;
+};
+
+// high resolution steady clock in nanoseconds
+auto nowNs() -> std::int64_t;
+
+// apply queued events pulled no later than untilNs to the game, in order,
+// and hand them to the recorder when there is one
+auto drainInput(InputQueue& queue, Game& game, std::int64_t untilNs, InputLatency& latency,
+				SessionRecorder* recorder = nullptr) -> void;
+
+#endif // INPUT_H
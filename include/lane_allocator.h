@@ -0,0 +1,64 @@
+#ifndef LANE_ALLOCATOR_H
+#define LANE_ALLOCATOR_H
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "rng.h"
+
+// Hands out horizontal lanes for new words so they never overlap.
+// The playfield height is cut into lanes of a fixed height, a lane is busy
+// for a time given by whoever takes it, usually until its word cleared the
+// spawn edge. Words move at constant speed, so the lane is put back on a
+// timer and there is no scan over active words. A lane with no words left
+// in it is free right away.
+// Free lanes are kept like WordPool ids, taking a random one is O(1) and
+// returning timed out lanes is O(log n) through a min heap.
+class LaneAllocator {
+public:
+	// lanes of laneHeight, the first at top and the last at or above bottom
+	LaneAllocator(float top, float bottom, float laneHeight);
+
+	// forget all words and free every lane
+	auto reset() -> void;
+	// move the lane clock forward and free lanes whose word left the edge
+	auto advance(float dt) -> void;
+
+	// take a random free lane for a word that clears the spawn edge after
+	// clearTime seconds, returns -1 when every lane is busy
+	auto take(RandomEngine& gen, float clearTime) -> int;
+	// a word in the lane is gone, the last one leaving frees the lane early
+	auto leave(int lane) -> void;
+
+	// y of the lane top
+	auto laneY(int lane) const -> float;
+	auto laneCount() const -> int;
+	auto freeCount() const -> int;
+
+private:
+	// put lane back into the free list
+	auto free(int lane) -> void;
+
+	struct Pending {
+		double clearAt;
+		int lane;
+		std::uint32_t token; // stale entries no longer match the lane token
+
+		auto operator>(const Pending& other) const -> bool { return clearAt > other.clearAt; }
+	};
+
+	static constexpr int absent = -1;
+
+	float top;
+	float laneHeight;
+	double now = 0.0;
+
+	std::vector<int> freeLanes;           // unordered free lanes
+	std::vector<int> positions;           // position of every lane in freeLanes, or absent
+	std::vector<std::uint32_t> tokens;    // bumped every time a lane is taken or emptied
+	std::vector<int> occupants;           // words living in every lane
+	std::priority_queue<Pending, std::vector<Pending>, std::greater<>> pending;
+};
+
+#endif // LANE_ALLOCATOR_H
@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	auto operator=(const MappedFile&) -> MappedFile& = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+	// map file into memory, returns false when it cannot be opened
+	auto open(const std::string& path) -> bool;
+	auto close() -> void;
+
+	auto data() const -> const char*;
+	auto size() const -> std::size_t;
+	auto view() const -> std::string_view;
+	auto isOpen() const -> bool;
+
+private:
+	const char* mapped = nullptr;
+	std::size_t length = 0;
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,109 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+#pragma once
+
+// Frame profiler. Scopes marked with MONKE_PROFILE_SCOPE record their start and
+// duration into a fixed ring of frames, which can be shown as percentiles or
+// exported to Chrome trace JSON (chrome://tracing, Perfetto) and CSV.
+// Without MONKE_PROFILING the macros expand to nothing and the profiler is not built.
+
+#ifdef MONKE_PROFILING
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Profiler {
+public:
+	static constexpr std::size_t maxFrames = 600;
+	static constexpr std::size_t maxStagesPerFrame = 64;
+
+	struct Stage {
+		const char* name;
+		std::int64_t startNs;
+		std::int64_t durationNs;
+		int depth;
+	};
+
+	struct Frame {
+		std::int64_t startNs = 0;
+		std::int64_t durationNs = 0;
+		std::uint64_t allocations = 0; // heap allocations made during the frame
+		std::array<Stage, maxStagesPerFrame> stages{};
+		std::size_t stageCount = 0;
+	};
+
+	// profiler of the calling thread, the render and the simulation thread record their own frames,
+	// it is allocated on the first call so threads that never record do not carry one
+	static auto instance() -> Profiler&;
+	// profiler of the calling thread, nullptr when it never asked for one
+	static auto current() -> Profiler*;
+
+	// close the running frame and open a new one
+	auto beginFrame() -> void;
+	// open a stage inside the running frame, returns its slot
+	auto beginStage(const char* name) -> std::size_t;
+	auto endStage(std::size_t slot) -> void;
+
+	// number of finished frames kept, oldest first
+	auto frameCount() const -> std::size_t;
+	auto frame(std::size_t i) const -> const Frame&;
+
+	// frame time statistics over the kept frames
+	auto frameTimePercentileMs(double p) -> double;
+	auto maxFrameTimeMs() const -> double;
+	// mean time of a stage per frame over the kept frames
+	auto stageMeanMs(const char* name) const -> double;
+	// heap allocations per frame over the kept frames
+	auto meanAllocations() const -> double;
+	auto maxAllocations() const -> std::uint64_t;
+
+	// export kept frames, returns false when the file cannot be written
+	auto exportChromeTrace(const std::string& path) const -> bool;
+	auto exportCsv(const std::string& path) const -> bool;
+
+private:
+	static constexpr std::size_t noSlot = SIZE_MAX;
+
+	std::array<Frame, maxFrames> frames{};
+	std::size_t next = 0;     // frame being recorded
+	std::size_t finished = 0; // finished frames kept
+	bool frameOpen = false;
+	std::uint64_t frameStartAllocations = 0;
+	int depth = 0;
+	std::array<std::int64_t, maxFrames> scratch{}; // for percentiles
+};
+
+// stage measured from construction to destruction
+class ProfileScope {
+public:
+	explicit ProfileScope(const char* name)
+		: profiler(Profiler::current()), slot(profiler != nullptr ? profiler->beginStage(name) : 0) {}
+	~ProfileScope() {
+		if (profiler != nullptr) {
+			profiler->endStage(slot);
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	auto operator=(const ProfileScope&) -> ProfileScope& = delete;
+
+private:
+	Profiler* profiler;
+	std::size_t slot;
+};
+
+#define MONKE_PROFILE_CONCAT_INNER(a, b) a##b
+#define MONKE_PROFILE_CONCAT(a, b) MONKE_PROFILE_CONCAT_INNER(a, b)
+#define MONKE_PROFILE_SCOPE(name) const ProfileScope MONKE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define MONKE_PROFILE_FRAME() Profiler::instance().beginFrame()
+
+#else
+
+#define MONKE_PROFILE_SCOPE(name) ((void)0)
+#define MONKE_PROFILE_FRAME() ((void)0)
+
+#endif // MONKE_PROFILING
+
+#endif // PROFILER_H
@@ -0,0 +1,34 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+#pragma once
+
+#ifdef MONKE_PROFILING
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// On-screen frame time percentiles and per-stage means, F3 toggles it,
+// F4 exports recorded frames to monke_trace.json and monke_trace.csv
+class ProfilerOverlay {
+public:
+	// constructor
+	ProfilerOverlay(const sf::Font& font, std::vector<const char*> stageNames);
+
+	auto toggle() -> void;
+	auto isVisible() const -> bool;
+	auto exportFrames() const -> void;
+	// refresh text a few times per second and draw it when visible
+	auto draw(sf::RenderTarget& target) -> void;
+
+private:
+	std::vector<const char*> stageNames;
+	sf::Text text;
+	sf::Clock refreshClock;
+	std::string buffer;
+	bool visible = false;
+};
+
+#endif // MONKE_PROFILING
+
+#endif // PROFILER_OVERLAY_H
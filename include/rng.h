@@ -0,0 +1,26 @@
+#ifndef RNG_H
+#define RNG_H
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// The one random engine type of the game. Everything that decides what
+// happens in a round draws from the engine owned by Game, so a round is
+// reproduced exactly from its seed and the input.
+using RandomEngine = std::mt19937;
+
+// fresh seed from the OS entropy source, for rounds that are not replayed
+auto randomSeed() -> std::uint32_t;
+
+// Bounded draws are computed from the raw engine output here. The algorithms of
+// the std distributions are left to the standard library, a recording made
+// with one would replay differently with another.
+// uniform integer in [0, bound), bound must not be 0
+auto uniformBelow(RandomEngine& gen, std::uint32_t bound) -> std::uint32_t;
+// uniform integer in [0, bound) from two draws, bound must not be 0
+auto uniformBelow64(RandomEngine& gen, std::uint64_t bound) -> std::uint64_t;
+// uniform float in [0, 1) from the top 24 bits of one draw
+auto uniformUnit(RandomEngine& gen) -> float;
+
+#endif // RNG_H
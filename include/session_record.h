@@ -0,0 +1,70 @@
+#ifndef SESSION_RECORD_H
+#define SESSION_RECORD_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "game.h"
+#include "input.h"
+
+// everything besides the words a round has to be replayed with
+struct SessionHeader {
+	std::uint32_t seed = 0;
+	float tickDuration = 0.f;
+	float worldWidth = 0.f;
+	int fontCount = 0;
+	GameLimits limits;
+	std::uint64_t dictionaryChecksum = 0;
+};
+
+// input event applied after tick ticks of the round, timestamp relative to the round start
+struct RecordedInput {
+	std::uint64_t tick = 0;
+	InputEvent event;
+};
+
+// Records one round as it is played. Events are encoded as they come into a
+// buffer reserved up front: the number of ticks since the previous event and
+// the timestamp difference as varints, the type as a byte and the code point
+// of a character as a varint, so typical events take four to six bytes and
+// recording does not allocate.
+class SessionRecorder {
+public:
+	// constructor, reserves room for about an hour of fast typing
+	SessionRecorder();
+
+	// start recording a round, startNs is the steady clock time of its start
+	auto begin(const SessionHeader& header, std::int64_t startNs) -> void;
+	auto isRecording() const -> bool;
+	// event applied to the game before the next tick
+	auto input(const InputEvent& event) -> void;
+	// one simulation tick ran
+	auto tick() -> void;
+	// end the round with the checksum of its final state and write it to path,
+	// returns false when the file can not be written
+	auto finish(std::uint64_t finalChecksum, const std::string& path) -> bool;
+
+private:
+	SessionHeader header;
+	std::int64_t startNs = 0;
+	bool recording = false;
+	std::uint64_t ticks = 0;
+	std::uint64_t lastEventTick = 0;
+	std::int64_t lastTimestampNs = 0;
+	std::uint64_t eventCount = 0;
+	std::string events; // encoded events
+};
+
+// a recorded round read back for replay
+struct SessionRecording {
+	SessionHeader header;
+	std::uint64_t tickCount = 0;
+	std::uint64_t finalChecksum = 0;
+	std::vector<RecordedInput> inputs;
+
+	// read a recording, returns false and prints why when it is broken
+	auto load(const std::string& path) -> bool;
+};
+
+#endif // SESSION_RECORD_H
@@ -0,0 +1,80 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "frame_snapshot.h"
+#include "game.h"
+#include "input.h"
+#include "session_record.h"
+#include "timestep.h"
+#include "triple_buffer.h"
+
+// Runs Game on its own thread at a steady tick rate. Typed events come in through
+// the input queue, after every pass of ticks a snapshot of what to draw is
+// published through a triple buffer, so neither thread ever waits for the other
+// and a stalled frame does not hold up ticks or input. While no round runs, or
+// the round is paused, the thread sleeps until the render thread wakes it.
+class Simulation {
+public:
+	// game and input have to outlive the simulation, rounds are recorded into
+	// recordPath unless it is empty
+	Simulation(Game& game, InputQueue& input, int tickRate, std::string recordPath);
+	// stops the thread, a round still running is recorded as it is
+	~Simulation();
+
+	Simulation(const Simulation&) = delete;
+	auto operator=(const Simulation&) -> Simulation& = delete;
+
+	// render thread side, start a new round, snapshots of it carry the returned number
+	auto startRound(std::uint32_t seed) -> std::uint32_t;
+	auto setPaused(bool paused) -> void;
+	// newest snapshot, stays unchanged until the next call
+	auto latest() -> const FrameSnapshot&;
+	// end the thread, after that the latency totals can be read
+	auto stop() -> void;
+	auto inputLatency() const -> const InputLatency&;
+	// export the profiler frames of the simulation thread, done by that thread on its next pass
+	auto requestProfileExport() -> void;
+
+private:
+	auto run(std::stop_token stop) -> void;
+	// reset the game for the requested round
+	auto beginRound(std::uint32_t round) -> void;
+	// run the ticks that are due, returns when the next one is
+	auto advance() -> std::int64_t;
+	auto publish(std::int64_t tickNs) -> void;
+	auto endRound() -> void;
+	// wake the thread after a request
+	auto notify() -> void;
+	// write the profiler frames of this thread
+	auto exportFrames() -> void;
+
+	Game& game;
+	InputQueue& input;
+	std::string recordPath;
+
+	// requests of the render thread
+	std::atomic<std::uint32_t> requestedRound{0};
+	std::atomic<std::uint32_t> requestedSeed{0};
+	std::atomic<bool> paused{false};
+	std::atomic<bool> exportProfile{false};
+	std::atomic<std::uint32_t> wakeups{0}; // bumped with every request, the idle thread waits on it
+
+	// simulation thread only
+	FixedTimestep timestep;
+	std::uint32_t round = 0;
+	bool running = false;
+	std::int64_t lastNs = 0;
+	InputLatency latency;
+	SessionRecorder recorder;
+	std::uint64_t dictionaryChecksum = 0; // for recordings
+
+	TripleBuffer<FrameSnapshot> snapshots;
+	std::jthread thread;
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,82 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Lock-free single producer, single consumer ring buffer with fixed capacity.
+// Indices grow forever and are masked on access, the producer only writes tail
+// and the consumer only writes head, each keeps a cached copy of the other index
+// so the shared cache line is touched only when the ring looks full or empty.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+	// producer side, returns false when the ring is full
+	auto push(const T& value) -> bool {
+		const std::size_t t = tail.load(std::memory_order_relaxed);
+		if (t - cachedHead == Capacity) {
+			cachedHead = head.load(std::memory_order_acquire);
+			if (t - cachedHead == Capacity) {
+				return false;
+			}
+		}
+		buffer[t & mask] = value;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer side, oldest element or nullptr when the ring is empty
+	auto front() -> T* {
+		const std::size_t h = head.load(std::memory_order_relaxed);
+		if (h == cachedTail) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (h == cachedTail) {
+				return nullptr;
+			}
+		}
+		return &buffer[h & mask];
+	}
+
+	// consumer side, drop the element returned by front
+	auto pop() -> void {
+		head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// consumer side, copy out and drop the oldest element
+	auto tryPop(T& out) -> bool {
+		T* value = front();
+		if (value == nullptr) {
+			return false;
+		}
+		out = *value;
+		pop();
+		return true;
+	}
+
+	// consumer side, drop everything
+	auto clear() -> void {
+		while (front() != nullptr) {
+			pop();
+		}
+	}
+
+	static constexpr auto capacity() -> std::size_t {
+		return Capacity;
+	}
+
+private:
+	static constexpr std::size_t mask = Capacity - 1;
+	static constexpr std::size_t cacheLine = 64;
+
+	alignas(cacheLine) std::atomic<std::size_t> head{0}; // next element to read
+	std::size_t cachedTail = 0;                           // consumer copy of tail
+	alignas(cacheLine) std::atomic<std::size_t> tail{0}; // next slot to write
+	std::size_t cachedHead = 0;                           // producer copy of head
+	alignas(cacheLine) std::array<T, Capacity> buffer{};
+};
+
+#endif // SPSC_RING_H
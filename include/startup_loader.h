@@ -0,0 +1,54 @@
+#ifndef STARTUP_LOADER_H
+#define STARTUP_LOADER_H
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <vector>
+
+// true once the result of a startup job can be taken without blocking
+template <typename T>
+auto isReady(const std::shared_future<T>& future) -> bool {
+	return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Runs startup jobs on their own threads while the main thread keeps drawing.
+// Every job hands back a future for its result, the loader only counts how
+// many of them finished so the title screen can show progress.
+class StartupLoader {
+public:
+	StartupLoader() = default;
+	StartupLoader(const StartupLoader&) = delete;
+	auto operator=(const StartupLoader&) -> StartupLoader& = delete;
+
+	// start job on a worker thread, an exception it throws is rethrown by get()
+	template <typename Job>
+	auto add(Job job) -> std::shared_future<std::invoke_result_t<Job>> {
+		auto future = std::async(std::launch::async, std::move(job)).share();
+		finished.emplace_back([future] { return isReady(future); });
+		return future;
+	}
+
+	// number of jobs that already returned, never blocks
+	auto completed() const -> int {
+		int count = 0;
+		for (const auto& isFinished : finished) {
+			count += isFinished() ? 1 : 0;
+		}
+		return count;
+	}
+	auto total() const -> int {
+		return static_cast<int>(finished.size());
+	}
+	auto done() const -> bool {
+		return completed() == total();
+	}
+
+private:
+	// the futures themselves are kept by whoever wants the results
+	std::vector<std::function<bool()>> finished;
+};
+
+#endif // STARTUP_LOADER_H
@@ -0,0 +1,31 @@
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+#pragma once
+
+// Fixed timestep clock. Real frame time is collected in an accumulator and paid
+// out in whole simulation ticks, the remainder is the interpolation factor used
+// to draw between the last two simulated states.
+class FixedTimestep {
+public:
+	// constructor
+	explicit FixedTimestep(double tickRate = 120.0, int maxTicksPerFrame = 8);
+
+	// add elapsed real time, returns number of ticks to simulate now
+	auto advance(double elapsed) -> int;
+	// drop accumulated time, e.g. while paused
+	auto reset() -> void;
+
+	auto setTickRate(double tickRate) -> void;
+	// simulated seconds per tick
+	auto tickDuration() const -> float;
+	// how far between the previous and the current tick we are, 0..1
+	auto alpha() const -> float;
+
+private:
+	double step;
+	double accumulator = 0.0;
+	// catch-up cap, a long hitch is dropped instead of simulated tick by tick
+	int maxTicksPerFrame;
+};
+
+#endif // TIMESTEP_H
@@ -0,0 +1,54 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single producer, single consumer triple buffer. The producer fills
+// its back slot and publishes it by swapping it with the middle slot, the
+// consumer takes the middle slot when it holds something newer than its front
+// slot. Neither side ever waits, the producer may publish faster than the
+// consumer reads and the consumer then skips to the newest value.
+template <typename T>
+class TripleBuffer {
+public:
+	// before either side runs, e.g. to reserve storage in all slots
+	template <typename F>
+	auto forEach(F&& f) -> void {
+		for (T& slot : slots) {
+			f(slot);
+		}
+	}
+
+	// producer side, the slot to fill, it stays the producer's until publish
+	auto back() -> T& {
+		return slots[backIndex];
+	}
+
+	// producer side, hand the back slot over and continue with an old one
+	auto publish() -> void {
+		backIndex = middle.exchange(static_cast<std::uint8_t>(backIndex | fresh), std::memory_order_acq_rel) & indexMask;
+	}
+
+	// consumer side, newest published value, stays unchanged until the next call
+	auto front() -> const T& {
+		if (middle.load(std::memory_order_relaxed) & fresh) {
+			frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+		}
+		return slots[frontIndex];
+	}
+
+private:
+	static constexpr std::uint8_t fresh = 4;      // middle holds a value the consumer has not seen
+	static constexpr std::uint8_t indexMask = 3;
+	static constexpr std::size_t cacheLine = 64;
+
+	std::array<T, 3> slots{};
+	alignas(cacheLine) std::atomic<std::uint8_t> middle{1}; // slot in between, plus the fresh bit
+	alignas(cacheLine) std::uint8_t backIndex = 0;          // producer only
+	alignas(cacheLine) std::uint8_t frontIndex = 2;         // consumer only
+};
+
+#endif // TRIPLE_BUFFER_H
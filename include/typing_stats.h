@@ -0,0 +1,87 @@
+#ifndef TYPING_STATS_H
+#define TYPING_STATS_H
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Typing statistics with O(1) work per event and no allocation or locking.
+// Events go into a fixed ring covering the rolling window, window sums are
+// updated when events enter and leave it. Session totals and the inter-key
+// latency histogram are plain counters.
+class TypingStats {
+public:
+	// rolling window for words per minute and recent accuracy
+	static constexpr std::int64_t windowNs = 60'000'000'000;
+	// inter-key latency histogram, 10 ms buckets up to 2 s plus an overflow bucket
+	static constexpr int latencyBucketMs = 10;
+	static constexpr std::size_t latencyBuckets = 201;
+
+	// forget everything, start of a new round
+	auto reset() -> void;
+
+	// printable character typed, correct when some word on screen still starts with the input
+	auto recordKey(std::int64_t timestampNs, bool correct) -> void;
+	auto recordBackspace(std::int64_t timestampNs) -> void;
+	// enter pressed with the given input length, hit when it destroyed a word
+	auto recordEnter(std::int64_t timestampNs, std::size_t length, bool hit) -> void;
+
+	// words per minute over the rolling window, a word being 5 characters
+	auto wpm(std::int64_t nowNs) -> double;
+	// correct keys out of all typed keys, 0..1
+	auto accuracy() const -> double;
+	auto recentAccuracy(std::int64_t nowNs) -> double;
+	// inter-key latency in milliseconds at percentile p (0..1)
+	auto latencyPercentileMs(double p) const -> double;
+	auto meanLatencyMs() const -> double;
+
+	// session totals
+	auto keystrokes() const -> std::int64_t;
+	auto backspaces() const -> std::int64_t;
+	auto wordsHit() const -> std::int64_t;
+	auto wordsMissed() const -> std::int64_t;
+
+private:
+	enum class Kind : std::uint8_t { Key, Backspace, Enter };
+
+	struct Event {
+		std::int64_t timestampNs;
+		std::uint32_t chars; // characters counted towards WPM
+		Kind kind;
+		bool correct;
+	};
+
+	// add event to the ring and the window sums
+	auto push(const Event& event) -> void;
+	// drop events that left the window
+	auto evict(std::int64_t nowNs) -> void;
+	auto evictOldest() -> void;
+	auto recordLatency(std::int64_t timestampNs) -> void;
+
+	static constexpr std::size_t ringSize = 4096;
+	std::array<Event, ringSize> ring{};
+	std::size_t head = 0; // oldest event
+	std::size_t count = 0;
+
+	// sums over events in the ring
+	std::int64_t windowChars = 0;
+	std::int64_t windowKeys = 0;
+	std::int64_t windowCorrect = 0;
+	std::int64_t firstTimestampNs = -1; // first event of the session
+
+	// session totals
+	std::int64_t totalKeys = 0;
+	std::int64_t totalCorrect = 0;
+	std::int64_t totalBackspaces = 0;
+	std::int64_t totalHits = 0;
+	std::int64_t totalMisses = 0;
+
+	// inter-key latency
+	std::array<std::int64_t, latencyBuckets> latencyHistogram{};
+	std::int64_t latencyCount = 0;
+	std::int64_t latencyTotalNs = 0;
+	std::int64_t lastKeyNs = -1;
+};
+
+#endif // TYPING_STATS_H
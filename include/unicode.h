@@ -0,0 +1,36 @@
+#ifndef UNICODE_H
+#define UNICODE_H
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Unicode helpers for word lists and typed input. Words are decoded from UTF-8
+// and composed once when the dictionary loads, from then on words and input
+// are compared code point by code point.
+
+// decode UTF-8 and append the code points to out, returns false and leaves out
+// unchanged on malformed input, overlong forms, surrogates and values past U+10FFFF
+auto decodeUtf8(std::string_view text, std::u32string& out) -> bool;
+
+// base followed by a combining mark as one precomposed code point, 0 when they do not compose
+auto compose(char32_t base, char32_t mark) -> char32_t;
+// canonical ordering of combining marks and composition of text from index
+// from on, in place, equal to NFC for text the composition table covers. The
+// table covers Latin, monotonic Greek, Cyrillic and the kana voicing marks, which
+// is what word lists and keyboards produce in decomposed form. Polytonic Greek
+// from the Greek Extended block is left decomposed. scratch is working storage,
+// callers keep it so that composing does not allocate once it has grown.
+auto composeFrom(std::u32string& text, std::size_t from, std::u32string& scratch) -> void;
+
+// combining marks, joiners, variation selectors and skin tone modifiers belong
+// to the grapheme before them
+auto extendsGrapheme(char32_t c) -> bool;
+// index where the last grapheme of text starts, 0 for empty text
+auto lastGraphemeStart(std::u32string_view text) -> std::size_t;
+
+// code point that can be typed and drawn, no control characters or surrogates
+auto isPrintable(char32_t c) -> bool;
+
+#endif // UNICODE_H
@@ -3,10 +3,11 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
-#include <atomic>
-#include <thread>
+#include <cstddef>
 #include <string>
+#include "audio_engine.h"
+#include "game.h"
+#include "rng.h"
 
 // enum class with game phases
 enum class GamePhase { Title, Playing, GameOver };
@@ -18,11 +19,13 @@ public:
     Window(int width,
 		int height,
 		const std::string& title,
-		int frameRate);
+		int frameRate,
+		int tickRate = 120,
+		const GameLimits& limits = {},
+		std::string recordPath = {});
 
 	// destructor
     ~Window();
-	std::string playerInput;
     auto run() -> void;
 
 
@@ -32,9 +35,12 @@ private:
     int height;
     std::string title;
     int frameRate;
-
-    // atomic flag for the main loop
-    std::atomic<bool> running;
+    // simulation ticks per second, independent of frame rate
+    int tickRate;
+    // caps of the game, the stress mode or the normal game with overrides
+    GameLimits limits;
+    // every round is recorded into this file for replay, empty records nothing
+    std::string recordPath;
 
     // game phase
 	GamePhase phase;
@@ -42,18 +48,15 @@ private:
     // window object
     sf::RenderWindow window;
 
-    // music loop
-    sf::Music loop;
-    std::thread loopThread;
+    // music loop and sound effects
+    AudioEngine audio;
 
-	// player resources and score
-	int score = 0;
-	int lives = 6;
+	// pause flag
 	bool isPaused = false;
 };
 
 // helper functions
-auto loopThreadFn(sf::Music& loop, const std::atomic<bool>& running) -> void;
-auto generateRandomColor() -> sf::Color;
+auto generateRandomColor(RandomEngine& gen) -> sf::Color;
+auto bandColor(ColorBand band) -> sf::Color;
 
 #endif // WINDOW_H
@@ -0,0 +1,17 @@
+#ifndef WORD_HANDLE_H
+#define WORD_HANDLE_H
+#pragma once
+
+#include <cstdint>
+
+// Stable reference to a word on the screen. The word can change slots while
+// it lives, the handle stays the same. Once the word is gone its handle entry
+// is reused with the next generation, so old handles stop resolving.
+struct WordHandle {
+	std::uint32_t index = UINT32_MAX;
+	std::uint32_t generation = 0;
+
+	auto operator==(const WordHandle&) const -> bool = default;
+};
+
+#endif // WORD_HANDLE_H
@@ -0,0 +1,75 @@
+#ifndef WORD_INDEX_H
+#define WORD_INDEX_H
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "word_handle.h"
+
+// Trie over the words currently on the screen, narrowed while the player types.
+// Every typed character moves a cursor one node down, so prefix matching costs
+// O(typed length) and the words equal to the input are known before Enter is hit.
+// Children are linked through their first child and next sibling, nodes no
+// word passes through go to a free list and are reused, so once the trie
+// reached its working size it stops allocating.
+class WordIndex {
+public:
+	// constructor
+	WordIndex();
+
+	// add word, returns its terminal node
+	auto insert(std::u32string_view word, WordHandle handle) -> int;
+	// remove word ending at node
+	auto erase(int node, WordHandle handle) -> void;
+	// remove all words and typed input
+	auto clear() -> void;
+	// create nodeCount nodes up front
+	auto reserve(std::size_t nodeCount) -> void;
+
+	// typed input handling
+	auto push(char32_t c) -> void;
+	auto pop() -> void;
+	auto clearInput() -> void;
+	auto typed() const -> const std::u32string&;
+
+	// number of words starting with the typed input
+	auto candidateCount() const -> int;
+	// words equal to the typed input
+	auto exactMatches() const -> const std::vector<WordHandle>&;
+	// length of the highlighted prefix of the word ending at node
+	auto matchedLength(int node) const -> std::size_t;
+
+private:
+	struct Node {
+		std::vector<WordHandle> words; // words ending here
+		char32_t key;
+		int firstChild;
+		int nextSibling;
+		int parent;
+		int depth;
+		int prefixCount; // words passing through this node
+
+		Node(const char32_t key, const int parent, const int depth)
+			: key(key), firstChild(-1), nextSibling(-1), parent(parent), depth(depth), prefixCount(0) {}
+	};
+
+	// child of node for character c, -1 if there is none
+	auto findChild(int node, char32_t c) const -> int;
+	// new child of parent for character c, reused from the free list when possible
+	auto allocateNode(int parent, char32_t c) -> int;
+	// unlink node from its parent and put it on the free list
+	auto freeNode(int node) -> void;
+	// follow typed input as deep as the trie allows
+	auto extendPath() -> void;
+	// true when every typed character has a node
+	auto fullyMatched() const -> bool;
+
+	std::vector<Node> nodes;
+	std::vector<int> freeNodes;
+	std::u32string input;
+	std::vector<int> path; // node for every matched prefix, path[0] is the root
+};
+
+#endif // WORD_INDEX_H
@@ -0,0 +1,57 @@
+#ifndef WORD_POOL_H
+#define WORD_POOL_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "rng.h"
+
+// how likely a word is to be picked for spawning
+enum class WordWeighting { Uniform, ShortWords, LongWords, Frequency };
+
+// Pool of inactive word ids with constant time random take and give back.
+// Ids are kept unordered, taking one swaps it with the last id and pops it.
+// Weighted picks are exact: weights are turned into integers and summed in a
+// Fenwick tree over the ids, an id leaving or joining the pool updates it in
+// O(log n) and a pick walks it down in O(log n).
+class WordPool {
+public:
+	// fill the pool with ids 0..count-1
+	auto reset(std::size_t count) -> void;
+	// one weight per id, empty vector means uniform picking
+	auto setWeights(const std::vector<float>& newWeights) -> void;
+
+	// remove a random id from the pool, pool must not be empty
+	auto take(RandomEngine& gen) -> std::uint32_t;
+	// random id picked like take, but it stays in the pool
+	auto sample(RandomEngine& gen) const -> std::uint32_t;
+	// put id back into the pool
+	auto give(std::uint32_t id) -> void;
+
+	auto contains(std::uint32_t id) const -> bool;
+	auto size() const -> std::size_t;
+	auto empty() const -> bool;
+
+private:
+	// random position, weighted by the id stored there
+	auto pick(RandomEngine& gen) const -> std::size_t;
+	// remove id stored at the given position
+	auto removeAt(std::size_t pos) -> std::uint32_t;
+	// add delta to the weight sum of id, wraps around to subtract
+	auto addWeight(std::uint32_t id, std::uint64_t delta) -> void;
+	// sum the weights of the ids in the pool from scratch
+	auto rebuildTree() -> void;
+
+	static constexpr std::uint32_t absent = UINT32_MAX;
+	// the largest weight becomes this integer, smaller positive weights at least 1
+	static constexpr double weightScale = 1 << 24;
+
+	std::vector<std::uint32_t> ids;       // ids in the pool, unordered
+	std::vector<std::uint32_t> positions; // position of every id in ids, or absent
+	std::vector<std::uint32_t> weights;   // integer weight of every id, empty when uniform
+	std::vector<std::uint64_t> tree;      // Fenwick tree of the weights of ids in the pool, 1 based
+	std::uint64_t totalWeight = 0;
+};
+
+#endif // WORD_POOL_H
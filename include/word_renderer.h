@@ -0,0 +1,35 @@
+#ifndef WORD_RENDERER_H
+#define WORD_RENDERER_H
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "asset_registry.h"
+#include "frame_snapshot.h"
+
+// Draws all active words with one vertex array per font atlas. Geometry is laid out
+// the same way sf::Text does it, colors are per vertex so banding and prefix
+// highlight do not break the batch.
+class WordRenderer {
+public:
+	// constructor
+	WordRenderer(AssetRegistry& assets, unsigned characterSize);
+
+	// rebuild batches from the words of a snapshot, alpha blends between its last two ticks
+	auto build(const FrameSnapshot& snapshot, float alpha) -> void;
+	// one draw call per font that has words on the screen
+	auto draw(sf::RenderTarget& target) const -> void;
+
+private:
+	// append quads of one word to the batch of its font
+	auto appendWord(sf::VertexArray& batch, const sf::Font& font, std::u32string_view word,
+					sf::Vector2f position, sf::Color color, std::size_t highlighted) const -> void;
+
+	AssetRegistry& assets;
+	unsigned characterSize;
+	std::vector<sf::VertexArray> batches; // indexed by font handle
+};
+
+#endif // WORD_RENDERER_H
@@ -0,0 +1,211 @@
+#include "active_words.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MONKE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+ActiveWords::ActiveWords(const std::size_t capacity)
+	: maxWords(capacity) {
+	x.reserve(capacity);
+	prevX.reserve(capacity);
+	speedX.reserve(capacity);
+	band.reserve(capacity);
+	alive.reserve(capacity);
+	y.reserve(capacity);
+	text.reserve(capacity);
+	wordId.reserve(capacity);
+	fontIndex.reserve(capacity);
+	indexNode.reserve(capacity);
+	lane.reserve(capacity);
+	handle.reserve(capacity);
+
+	handleSlot.resize(capacity);
+	handleGeneration.resize(capacity, 0);
+	freeHandles.reserve(capacity);
+	deadSlots.reserve(capacity);
+	for (auto entry = static_cast<std::uint32_t>(capacity); entry-- > 0;) {
+		freeHandles.push_back(entry);
+	}
+}
+
+auto ActiveWords::add(const std::u32string_view word, const std::uint32_t id, const int font, const float startX,
+					  const float startY, const float speed, const int spawnLane) -> std::size_t {
+	x.push_back(startX);
+	prevX.push_back(startX);
+	speedX.push_back(speed);
+	band.push_back(ColorBand::Green);
+	alive.push_back(1);
+	y.push_back(startY);
+	text.push_back(word);
+	wordId.push_back(id);
+	fontIndex.push_back(font);
+	indexNode.push_back(-1);
+	lane.push_back(spawnLane);
+
+	const std::uint32_t entry = freeHandles.back();
+	freeHandles.pop_back();
+	handleSlot[entry] = static_cast<std::uint32_t>(x.size() - 1);
+	handle.push_back({entry, handleGeneration[entry]});
+	return x.size() - 1;
+}
+
+auto ActiveWords::move(const std::size_t from, const std::size_t to) -> void {
+	x[to] = x[from];
+	prevX[to] = prevX[from];
+	speedX[to] = speedX[from];
+	band[to] = band[from];
+	alive[to] = alive[from];
+	y[to] = y[from];
+	text[to] = text[from];
+	wordId[to] = wordId[from];
+	fontIndex[to] = fontIndex[from];
+	indexNode[to] = indexNode[from];
+	lane[to] = lane[from];
+	handle[to] = handle[from];
+	handleSlot[handle[to].index] = static_cast<std::uint32_t>(to);
+}
+
+// Mark the word dead, it keeps its slot until removeDead
+auto ActiveWords::kill(const std::size_t slot) -> void {
+	if (!alive[slot]) {
+		return;
+	}
+	alive[slot] = 0;
+	deadSlots.push_back(slot);
+}
+
+auto ActiveWords::dead() const -> const std::vector<std::size_t>& {
+	return deadSlots;
+}
+
+// The last word fills every hole, going from the highest dead slot down means
+// the last word is never one waiting to be removed. Shrinking keeps the capacity.
+auto ActiveWords::removeDead() -> void {
+	if (deadSlots.empty()) {
+		return;
+	}
+	std::ranges::sort(deadSlots, std::greater<>());
+	std::size_t count = x.size();
+	for (const std::size_t slot : deadSlots) {
+		releaseHandle(handle[slot]);
+		if (slot != --count) {
+			move(count, slot);
+		}
+	}
+	deadSlots.clear();
+	x.resize(count);
+	prevX.resize(count);
+	speedX.resize(count);
+	band.resize(count);
+	alive.resize(count);
+	y.resize(count);
+	text.resize(count);
+	wordId.resize(count);
+	fontIndex.resize(count);
+	indexNode.resize(count);
+	lane.resize(count);
+	handle.resize(count);
+}
+
+auto ActiveWords::clear() -> void {
+	for (const WordHandle h : handle) {
+		releaseHandle(h);
+	}
+	x.clear();
+	prevX.clear();
+	speedX.clear();
+	band.clear();
+	alive.clear();
+	y.clear();
+	text.clear();
+	wordId.clear();
+	fontIndex.clear();
+	indexNode.clear();
+	lane.clear();
+	handle.clear();
+	deadSlots.clear();
+}
+
+auto ActiveWords::resolve(const WordHandle h) const -> std::size_t {
+	if (h.index >= handleGeneration.size() || handleGeneration[h.index] != h.generation) {
+		return npos;
+	}
+	const std::uint32_t slot = handleSlot[h.index];
+	return slot < handle.size() && handle[slot] == h ? slot : npos;
+}
+
+auto ActiveWords::releaseHandle(const WordHandle released) -> void {
+	handleGeneration[released.index]++;
+	freeHandles.push_back(released.index);
+}
+
+// Dead words move too, they are dropped at the end of the tick anyway and
+// skipping them would put a branch into the loop
+auto ActiveWords::integrate(const float dt) -> void {
+	const std::size_t count = x.size();
+	float *xs = x.data();
+	float *prev = prevX.data();
+	const float *speeds = speedX.data();
+	std::size_t i = 0;
+#ifdef MONKE_SSE2
+	const __m128 step = _mm_set1_ps(dt);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 pos = _mm_loadu_ps(xs + i);
+		_mm_storeu_ps(prev + i, pos);
+		_mm_storeu_ps(xs + i, _mm_add_ps(pos, _mm_mul_ps(_mm_loadu_ps(speeds + i), step)));
+	}
+#endif
+	for (; i < count; ++i) {
+		prev[i] = xs[i];
+		xs[i] += speeds[i] * dt;
+	}
+}
+
+// Band is the number of thresholds the word passed
+auto ActiveWords::classify(const float yellowX, const float redX) -> void {
+	const std::size_t count = x.size();
+	const float *xs = x.data();
+	auto *bands = reinterpret_cast<std::uint8_t *>(band.data());
+	std::size_t i = 0;
+#ifdef MONKE_SSE2
+	const __m128 yellow = _mm_set1_ps(yellowX);
+	const __m128 red = _mm_set1_ps(redX);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 pos = _mm_loadu_ps(xs + i);
+		// passed thresholds are all ones, that is -1 per lane
+		const __m128i passed = _mm_add_epi32(_mm_castps_si128(_mm_cmpge_ps(pos, yellow)),
+											 _mm_castps_si128(_mm_cmpge_ps(pos, red)));
+		const __m128i level = _mm_sub_epi32(_mm_setzero_si128(), passed);
+		const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(level, level), _mm_setzero_si128());
+		const int four = _mm_cvtsi128_si32(packed);
+		std::memcpy(bands + i, &four, sizeof(four));
+	}
+#endif
+	for (; i < count; ++i) {
+		bands[i] = static_cast<std::uint8_t>((xs[i] >= yellowX) + (xs[i] >= redX));
+	}
+}
+
+auto ActiveWords::interpolatedX(const std::size_t slot, const float alpha) const -> float {
+	return prevX[slot] + (x[slot] - prevX[slot]) * alpha;
+}
+
+auto ActiveWords::size() const -> std::size_t {
+	return x.size();
+}
+
+auto ActiveWords::empty() const -> bool {
+	return x.empty();
+}
+
+auto ActiveWords::full() const -> bool {
+	return x.size() >= maxWords;
+}
+
+auto ActiveWords::capacity() const -> std::size_t {
+	return maxWords;
+}
@@ -0,0 +1,36 @@
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// the replacements stay out of line, MSVC spells the attribute differently
+#ifdef _MSC_VER
+#define MONKE_NOINLINE __declspec(noinline)
+#else
+#define MONKE_NOINLINE [[gnu::noinline]]
+#endif
+
+namespace {
+	std::atomic<std::uint64_t> allocations{0};
+}
+
+auto heapAllocations() -> std::uint64_t {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+// array and nothrow forms call these by default
+MONKE_NOINLINE auto operator new(const std::size_t size) -> void* {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size == 0 ? 1 : size)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+MONKE_NOINLINE auto operator delete(void* p) noexcept -> void {
+	std::free(p);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void {
+	operator delete(p);
+}
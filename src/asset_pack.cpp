@@ -0,0 +1,181 @@
+#include "asset_pack.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach-o/dyld.h>
+#endif
+
+namespace {
+	constexpr std::string_view magic = "MONKEPAK";
+	constexpr std::uint32_t version = 1;
+	constexpr std::uint64_t alignment = 16;
+	// offset, size and name length of an index entry, the name follows
+	constexpr std::uint64_t entrySize = 20;
+
+	// byte by byte, so the format does not depend on the host byte order
+	auto readUint(const char* p, const int bytes) -> std::uint64_t {
+		std::uint64_t value = 0;
+		for (int i = bytes - 1; i >= 0; --i) {
+			value = value << 8 | static_cast<unsigned char>(p[i]);
+		}
+		return value;
+	}
+
+	auto appendUint(std::string& out, std::uint64_t value, const int bytes) -> void {
+		for (int i = 0; i < bytes; ++i) {
+			out += static_cast<char>(value & 0xff);
+			value >>= 8;
+		}
+	}
+}
+
+// Every offset and size is checked against the file, a broken pack is rejected as a whole
+auto AssetPack::open(const std::string& path) -> bool {
+	entries.clear();
+	if (!file.open(path)) {
+		return false;
+	}
+	const std::string_view bytes = file.view();
+	const auto fail = [&](const char* reason) {
+		std::cerr << "Broken asset pack " << path << ": " << reason << "\n";
+		entries.clear();
+		file.close();
+		return false;
+	};
+
+	if (bytes.size() < magic.size() + 8 || bytes.substr(0, magic.size()) != magic) {
+		return fail("bad header");
+	}
+	std::size_t pos = magic.size();
+	if (readUint(bytes.data() + pos, 4) != version) {
+		return fail("unsupported version");
+	}
+	const std::uint64_t count = readUint(bytes.data() + pos + 4, 4);
+	pos += 8;
+
+	// every entry takes at least entrySize bytes, a larger count can not be right
+	if (count > (bytes.size() - pos) / entrySize) {
+		return fail("entry count out of bounds");
+	}
+	entries.reserve(count);
+	for (std::uint64_t i = 0; i < count; ++i) {
+		if (bytes.size() - pos < entrySize) {
+			return fail("truncated index");
+		}
+		const std::uint64_t offset = readUint(bytes.data() + pos, 8);
+		const std::uint64_t size = readUint(bytes.data() + pos + 8, 8);
+		const std::uint64_t nameLength = readUint(bytes.data() + pos + 16, 4);
+		pos += entrySize;
+		if (bytes.size() - pos < nameLength || offset > bytes.size() || size > bytes.size() - offset) {
+			return fail("entry out of bounds");
+		}
+		entries.push_back({bytes.substr(pos, nameLength), bytes.substr(offset, size)});
+		pos += nameLength;
+	}
+	if (!std::ranges::is_sorted(entries, {}, &Entry::name)) {
+		return fail("index not sorted");
+	}
+	return true;
+}
+
+auto AssetPack::isOpen() const -> bool {
+	return file.isOpen();
+}
+
+auto AssetPack::find(const std::string_view name) const -> std::optional<std::string_view> {
+	const auto it = std::ranges::lower_bound(entries, name, {}, &Entry::name);
+	if (it == entries.end() || it->name != name) {
+		return std::nullopt;
+	}
+	return it->data;
+}
+
+auto AssetPack::names() const -> std::vector<std::string_view> {
+	std::vector<std::string_view> result;
+	result.reserve(entries.size());
+	for (const Entry &entry : entries) {
+		result.push_back(entry.name);
+	}
+	return result;
+}
+
+// Index first, contents after it, both built in memory and written at once
+auto AssetPack::write(const std::string& path, std::vector<std::pair<std::string, std::string>> files) -> bool {
+	std::ranges::sort(files, {}, &std::pair<std::string, std::string>::first);
+
+	std::uint64_t indexSize = magic.size() + 8;
+	for (const auto &[name, contents] : files) {
+		indexSize += entrySize + name.size();
+	}
+
+	std::string index(magic);
+	appendUint(index, version, 4);
+	appendUint(index, files.size(), 4);
+	std::string data;
+	for (const auto &[name, contents] : files) {
+		data.resize((data.size() + alignment - 1) / alignment * alignment, '\0');
+		const std::uint64_t start = (indexSize + alignment - 1) / alignment * alignment;
+		appendUint(index, start + data.size(), 8);
+		appendUint(index, contents.size(), 8);
+		appendUint(index, name.size(), 4);
+		index += name;
+		data += contents;
+	}
+	index.resize((index.size() + alignment - 1) / alignment * alignment, '\0');
+
+	std::ofstream out(path, std::ios::binary);
+	out.write(index.data(), static_cast<std::streamsize>(index.size()));
+	out.write(data.data(), static_cast<std::streamsize>(data.size()));
+	return static_cast<bool>(out);
+}
+
+auto executableDirectory() -> std::filesystem::path {
+	std::error_code ec;
+#ifdef _WIN32
+	wchar_t buffer[MAX_PATH];
+	if (const DWORD length = GetModuleFileNameW(nullptr, buffer, MAX_PATH); length > 0 && length < MAX_PATH) {
+		return std::filesystem::path(buffer).parent_path();
+	}
+#elif defined(__APPLE__)
+	char buffer[4096];
+	if (std::uint32_t size = sizeof(buffer); _NSGetExecutablePath(buffer, &size) == 0) {
+		return std::filesystem::canonical(buffer, ec).parent_path();
+	}
+#else
+	if (const auto exe = std::filesystem::read_symlink("/proc/self/exe", ec); !ec) {
+		return exe.parent_path();
+	}
+#endif
+	return std::filesystem::current_path(ec);
+}
+
+// Fonts are the .ttf files right in fonts/, sorted so handles do not depend on the file system order
+auto fontAssetNames(const AssetPack& pack, const std::filesystem::path& assetsDir) -> std::vector<std::string> {
+	namespace fs = std::filesystem;
+
+	std::vector<std::string> found;
+	if (pack.isOpen()) {
+		for (const std::string_view name : pack.names()) {
+			if (const fs::path p(name); p.parent_path() == "fonts" && p.extension() == ".ttf") {
+				found.emplace_back(name);
+			}
+		}
+	} else {
+		std::error_code ec;
+		for (const auto& entry : fs::directory_iterator(assetsDir / "fonts", ec)) {
+			if (entry.is_regular_file() && entry.path().extension() == ".ttf") {
+				found.push_back("fonts/" + entry.path().filename().string());
+			}
+		}
+		if (ec) {
+			std::cerr << "Cannot read fonts directory " << (assetsDir / "fonts").string() << ": " << ec.message() << "\n";
+		}
+	}
+	std::ranges::sort(found);
+	return found;
+}
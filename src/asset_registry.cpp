@@ -0,0 +1,117 @@
+#include "asset_registry.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+// constructor
+AssetRegistry::AssetRegistry(std::string assetsDir, const std::string &packPath)
+	: assetsDir(std::move(assetsDir)) {
+	if (pack.open(packPath)) {
+		std::cout << "Loading assets from " << packPath << "\n";
+	}
+}
+
+// Loose files stay mapped until the registry goes away, resources keep pointing into them
+auto AssetRegistry::bytes(const std::string &relative) -> std::string_view {
+	if (pack.isOpen()) {
+		if (const auto data = pack.find(relative)) {
+			return *data;
+		}
+		std::cerr << "Asset " << relative << " is not in the pack\n";
+		return {};
+	}
+	MappedFile file;
+	if (!file.open(path(relative))) {
+		std::cerr << "Cannot open asset " << path(relative) << "\n";
+		return {};
+	}
+	const std::lock_guard lock(looseMutex);
+	return looseFiles.emplace_back(std::move(file)).view();
+}
+
+// destructor, workers are joined before fonts go away
+AssetRegistry::~AssetRegistry() {
+	workers.clear();
+}
+
+// Collect fonts from the pack or the directory, the same way the headless run counts them
+auto AssetRegistry::discoverFonts() -> void {
+	namespace fs = std::filesystem;
+
+	const std::vector<std::string> found = fontAssetNames(pack, assetsDir);
+	fonts.clear();
+	fonts.reserve(found.size());
+	for (const auto &relative : found) {
+		fonts.push_back(std::make_unique<FontSlot>(fs::path(relative).stem().string(), relative, path(relative)));
+	}
+}
+
+// Workers take fonts one by one until all are loaded
+auto AssetRegistry::loadFontsAsync(const unsigned threadCount) -> void {
+	const unsigned count = std::clamp(threadCount, 1u, std::max(1u, static_cast<unsigned>(fonts.size())));
+	for (unsigned i = 0; i < count; ++i) {
+		workers.emplace_back([this] {
+			for (int handle = nextToLoad++; handle < fontCount(); handle = nextToLoad++) {
+				ensureLoaded(handle);
+			}
+		});
+	}
+}
+
+auto AssetRegistry::ensureLoaded(const FontHandle handle) -> FontSlot& {
+	FontSlot &slot = *fonts[handle];
+	std::call_once(slot.once, [&] {
+		// a font that does not load reports itself
+		slot.ok = slot.font.load(bytes(slot.relative));
+		++loadedFonts;
+	});
+	return slot;
+}
+
+auto AssetRegistry::fontHandle(const std::string &name) const -> FontHandle {
+	for (int i = 0; i < fontCount(); ++i) {
+		if (fonts[i]->font.name == name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Broken or unknown fonts are replaced by the first font that loads
+auto AssetRegistry::font(const FontHandle handle) -> Font& {
+	if (handle >= 0 && handle < fontCount()) {
+		if (FontSlot &slot = ensureLoaded(handle); slot.ok) {
+			return slot.font;
+		}
+	}
+	for (int i = 0; i < fontCount(); ++i) {
+		if (FontSlot &slot = ensureLoaded(i); slot.ok) {
+			return slot.font;
+		}
+	}
+	// nothing loaded, an empty font draws nothing but does not crash
+	static Font empty("", "");
+	return empty;
+}
+
+// Asking for a glyph renders it into the atlas page of that size and uploads the page
+auto AssetRegistry::prewarmGlyphs(const FontHandle handle, const std::u32string &characters, const unsigned characterSize) -> void {
+	const sf::Font &sfFont = font(handle).getSfFont();
+	// sf::Text always measures space and 'x' besides the drawn characters
+	for (const char32_t c : U" x" + characters) {
+		sfFont.getGlyph(static_cast<sf::Uint32>(c), characterSize, false);
+	}
+	sfFont.getTexture(characterSize);
+}
+
+auto AssetRegistry::fontCount() const -> int {
+	return static_cast<int>(fonts.size());
+}
+
+auto AssetRegistry::loadedFontCount() const -> int {
+	return loadedFonts.load();
+}
+
+auto AssetRegistry::path(const std::string &relative) const -> std::string {
+	return (std::filesystem::path(assetsDir) / relative).string();
+}
@@ -0,0 +1,90 @@
+#include "audio_engine.h"
+#include <iostream>
+
+// constructor
+AudioEngine::AudioEngine(const std::size_t voiceCount)
+	: voices(voiceCount), voiceEffect(voiceCount, -1) {}
+
+AudioEngine::~AudioEngine() {
+	for (auto &voice : voices) {
+		voice.stop();
+	}
+	stopMusic();
+}
+
+auto AudioEngine::loadEffect(const std::string &name, const std::string_view data) -> SoundHandle {
+	sf::SoundBuffer buffer;
+	if (data.empty() || !buffer.loadFromMemory(data.data(), data.size())) {
+		std::cout << "Failed to load sound " << name << "\n";
+		return -1;
+	}
+	effects.push_back(std::move(buffer));
+	return static_cast<SoundHandle>(effects.size()) - 1;
+}
+
+// Rebinding the buffer only happens when the voice played a different effect
+auto AudioEngine::play(const SoundHandle sound) -> void {
+	if (sound < 0 || sound >= static_cast<SoundHandle>(effects.size()) || voices.empty()) {
+		return;
+	}
+	sf::Sound &voice = voices[nextVoice];
+	if (voiceEffect[nextVoice] != sound) {
+		voice.setBuffer(effects[static_cast<std::size_t>(sound)]);
+		voiceEffect[nextVoice] = sound;
+	}
+	voice.play();
+	nextVoice = (nextVoice + 1) % voices.size();
+}
+
+auto AudioEngine::setEffectsVolume(const float volume) -> void {
+	for (auto &voice : voices) {
+		voice.setVolume(volume);
+	}
+}
+
+auto AudioEngine::loadMusic(const std::string &name, const std::string_view data, const bool inMemory) -> bool {
+	stopMusic();
+	musicInMemory = inMemory;
+	musicLoaded = !data.empty() && (inMemory ? musicBuffer.loadFromMemory(data.data(), data.size())
+											  : musicStream.openFromMemory(data.data(), data.size()));
+	if (!musicLoaded) {
+		std::cout << "Failed to open loop music " << name << "\n";
+		return false;
+	}
+	if (inMemory) {
+		musicVoice.setBuffer(musicBuffer);
+		musicVoice.setLoop(true);
+	} else {
+		musicStream.setLoop(true);
+	}
+	return true;
+}
+
+auto AudioEngine::playMusic() -> void {
+	if (!musicLoaded || isMusicPlaying()) {
+		return;
+	}
+	if (musicInMemory) {
+		musicVoice.play();
+	} else {
+		musicStream.play();
+	}
+}
+
+auto AudioEngine::stopMusic() -> void {
+	musicVoice.stop();
+	musicStream.stop();
+}
+
+auto AudioEngine::isMusicPlaying() const -> bool {
+	return musicInMemory ? musicVoice.getStatus() == sf::Sound::Playing : musicStream.getStatus() == sf::Music::Playing;
+}
+
+auto AudioEngine::setMusicVolume(const float volume) -> void {
+	musicVoice.setVolume(volume);
+	musicStream.setVolume(volume);
+}
+
+auto AudioEngine::musicVolume() const -> float {
+	return musicInMemory ? musicVoice.getVolume() : musicStream.getVolume();
+}
@@ -0,0 +1,205 @@
+#include "dictionary.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <version>
+#include "checksum.h"
+#include "mapped_file.h"
+#include "unicode.h"
+
+namespace {
+	constexpr char32_t maxCodePoint = 0x10ffff;
+
+	// the whole field has to be the number, no spaces or anything after it
+	auto parseFrequency(const char* first, const char* last, float& value) -> bool {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		const auto [ptr, ec] = std::from_chars(first, last, value);
+		return ec == std::errc() && ptr == last;
+#else
+		// libc++ had no from_chars for float for a long time, strtof needs a terminated copy
+		std::array<char, 32> field{};
+		const auto length = static_cast<std::size_t>(last - first);
+		if (length == 0 || length >= field.size() || std::isspace(static_cast<unsigned char>(first[0])) != 0 || first[0] == '+') {
+			return false;
+		}
+		std::memcpy(field.data(), first, length);
+		char* end = nullptr;
+		errno = 0;
+		value = std::strtof(field.data(), &end);
+		return errno == 0 && end == field.data() + length;
+#endif
+	}
+}
+
+// Load words from a file, one word per line
+auto Dictionary::loadFromFile(const std::string& filePath) -> bool {
+	clear();
+	MappedFile file;
+	if (!file.open(filePath)) {
+		std::cerr << "Cannot open words file: " << filePath << "\n";
+		return false;
+	}
+	// offsets are stored in 32 bits
+	if (file.size() > std::numeric_limits<std::uint32_t>::max()) {
+		std::cerr << "Words file too large: " << filePath << "\n";
+		return false;
+	}
+	// the words are decoded into the arena, the file is not needed afterwards
+	split(file.view());
+	if (rejected > 0) {
+		std::cerr << "Skipped " << rejected << " invalid lines in " << filePath << "\n";
+	}
+	return true;
+}
+
+auto Dictionary::loadFromMemory(const std::string_view bytes) -> bool {
+	clear();
+	// offsets are stored in 32 bits
+	if (bytes.size() > std::numeric_limits<std::uint32_t>::max()) {
+		std::cerr << "Words text too large\n";
+		return false;
+	}
+	split(bytes);
+	if (rejected > 0) {
+		std::cerr << "Skipped " << rejected << " invalid lines of words\n";
+	}
+	return true;
+}
+
+auto Dictionary::clear() -> void {
+	text.clear();
+	entries.clear();
+	frequencies.clear();
+	characters.clear();
+	longest = 0;
+	rejected = 0;
+}
+
+// Split text into words, a word is a non empty line of valid UTF-8 without
+// control characters, optionally followed by a tab and its frequency
+auto Dictionary::split(std::string_view bytes) -> void {
+	// byte order mark some editors put in front of UTF-8 files
+	if (bytes.starts_with("\xef\xbb\xbf")) {
+		bytes.remove_prefix(3);
+	}
+	// never more code points than bytes, so decoding does not regrow the arena
+	text.reserve(bytes.size());
+	// rough guess of the word count to avoid regrowing
+	entries.reserve(bytes.size() / 8);
+	// bit per code point in use, only while loading
+	std::vector<std::uint64_t> used((maxCodePoint + 64) / 64);
+	std::u32string composeScratch;
+
+	const char* begin = bytes.data();
+	const char* const end = begin + bytes.size();
+	while (begin < end) {
+		const auto* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+		const char* lineEnd = newline != nullptr ? newline : end;
+
+		// windows line endings
+		std::size_t length = static_cast<std::size_t>(lineEnd - begin);
+		if (length > 0 && begin[length - 1] == '\r') {
+			length--;
+		}
+
+		// optional frequency column
+		float frequency = 1.f;
+		bool hasFrequency = false;
+		if (const auto* tab = static_cast<const char*>(std::memchr(begin, '\t', length)); tab != nullptr) {
+			hasFrequency = parseFrequency(tab + 1, begin + length, frequency) && frequency >= 0.f;
+			if (!hasFrequency) {
+				rejected++;
+				begin = lineEnd + 1;
+				continue;
+			}
+			length = static_cast<std::size_t>(tab - begin);
+		}
+
+		if (length > 0) {
+			const std::size_t offset = text.size();
+			bool valid = decodeUtf8({begin, length}, text);
+			if (valid) {
+				composeFrom(text, offset, composeScratch);
+				valid = std::all_of(text.begin() + static_cast<std::ptrdiff_t>(offset), text.end(), isPrintable);
+			}
+			if (valid) {
+				// frequencies are only stored once the first one shows up
+				if (hasFrequency && frequencies.size() < entries.size()) {
+					frequencies.resize(entries.size(), 1.f);
+				}
+				if (hasFrequency || !frequencies.empty()) {
+					frequencies.push_back(frequency);
+				}
+				const std::size_t wordLength = text.size() - offset;
+				entries.push_back({static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(wordLength)});
+				longest = std::max(longest, wordLength);
+				for (std::size_t i = offset; i < text.size(); ++i) {
+					used[text[i] / 64] |= std::uint64_t{1} << (text[i] % 64);
+				}
+			} else {
+				text.resize(offset);
+				rejected++;
+			}
+		}
+		begin = lineEnd + 1;
+	}
+	text.shrink_to_fit();
+	entries.shrink_to_fit();
+	frequencies.shrink_to_fit();
+
+	for (std::size_t block = 0; block < used.size(); ++block) {
+		for (std::uint64_t bits = used[block]; bits != 0; bits &= bits - 1) {
+			characters += static_cast<char32_t>(block * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+		}
+	}
+}
+
+auto Dictionary::size() const -> std::size_t {
+	return entries.size();
+}
+
+auto Dictionary::empty() const -> bool {
+	return entries.empty();
+}
+
+auto Dictionary::operator[](const std::uint32_t id) const -> std::u32string_view {
+	const Entry& entry = entries[id];
+	return {text.data() + entry.offset, entry.length};
+}
+
+auto Dictionary::hasFrequencies() const -> bool {
+	return !frequencies.empty();
+}
+
+auto Dictionary::frequency(const std::uint32_t id) const -> float {
+	return frequencies.empty() ? 1.f : frequencies[id];
+}
+
+auto Dictionary::longestWord() const -> std::size_t {
+	return longest;
+}
+
+// All distinct code points the words are made of, collected while loading
+auto Dictionary::charset() const -> const std::u32string& {
+	return characters;
+}
+
+auto Dictionary::checksum() const -> std::uint64_t {
+	Checksum sum;
+	for (std::uint32_t id = 0; id < size(); ++id) {
+		sum.add((*this)[id]);
+		sum.add(U'\n');
+	}
+	return sum.value();
+}
+
+auto Dictionary::rejectedLines() const -> std::size_t {
+	return rejected;
+}
@@ -0,0 +1,78 @@
+#include "edit_distance.h"
+
+auto EditDistance::setPattern(const std::u32string_view pattern) -> bool {
+	if (pattern.empty() || pattern.size() > maxPattern) {
+		length = 0;
+		return false;
+	}
+	asciiMasks.fill(0);
+	otherCount = 0;
+	length = pattern.size();
+	for (std::size_t i = 0; i < length; ++i) {
+		const char32_t c = pattern[i];
+		const std::uint64_t bit = std::uint64_t{1} << i;
+		if (c < asciiMasks.size()) {
+			asciiMasks[c] |= bit;
+			continue;
+		}
+		std::size_t slot = 0;
+		while (slot < otherCount && otherChars[slot] != c) {
+			slot++;
+		}
+		if (slot == otherCount) {
+			otherChars[otherCount] = c;
+			otherMasks[otherCount++] = 0;
+		}
+		otherMasks[slot] |= bit;
+	}
+	return true;
+}
+
+auto EditDistance::mask(const char32_t c) const -> std::uint64_t {
+	if (c < asciiMasks.size()) {
+		return asciiMasks[c];
+	}
+	for (std::size_t slot = 0; slot < otherCount; ++slot) {
+		if (otherChars[slot] == c) {
+			return otherMasks[slot];
+		}
+	}
+	return 0;
+}
+
+// Pv and Mv are the +1 and -1 vertical differences of the current column, the
+// score follows the bottom cell. The top row is the distance to the empty
+// pattern, it grows by one per text character, hence the 1 shifted into Ph.
+auto EditDistance::distance(const std::u32string_view text, const int limit) const -> int {
+	const auto m = static_cast<int>(length);
+	const auto n = static_cast<int>(text.size());
+	// every character the lengths differ by is an insertion or a deletion
+	if (m == 0 || (m > n ? m - n : n - m) > limit) {
+		return limit + 1;
+	}
+	const std::uint64_t high = std::uint64_t{1} << (m - 1);
+	std::uint64_t pv = ~std::uint64_t{0};
+	std::uint64_t mv = 0;
+	int score = m;
+	for (int j = 0; j < n; ++j) {
+		const std::uint64_t eq = mask(text[j]);
+		const std::uint64_t xv = eq | mv;
+		const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+		std::uint64_t ph = mv | ~(xh | pv);
+		std::uint64_t mh = pv & xh;
+		if (ph & high) {
+			score++;
+		} else if (mh & high) {
+			score--;
+		}
+		// the score drops by at most one per character left
+		if (score - (n - j - 1) > limit) {
+			return limit + 1;
+		}
+		ph = (ph << 1) | 1;
+		mh <<= 1;
+		pv = mh | ~(xv | ph);
+		mv = ph & xv;
+	}
+	return score <= limit ? score : limit + 1;
+}
@@ -7,9 +7,9 @@ Font::Font(std::string name, std::string fontPath)
     :name(std::move(name)), fontPath(std::move(fontPath)) {
 }
 // font loading
-bool Font::load() {
-    if (!sfFont.loadFromFile(fontPath)) {
-        std::cout << "Failed to load font from '" << fontPath << "'";
+bool Font::load(const std::string_view data) {
+    if (data.empty() || !sfFont.loadFromMemory(data.data(), data.size())) {
+        std::cerr << "Failed to load font from '" << fontPath << "'\n";
         return false;
     }
     return true;
@@ -17,4 +17,4 @@ bool Font::load() {
 // font access
 sf::Font &Font::getSfFont()  {
     return sfFont;
-}
\ No newline at end of file
+}
@@ -0,0 +1,72 @@
+#include "font_slots.h"
+#include <bit>
+
+FontSlots::FontSlots(const int count, const int quota)
+	: count(count), quota(quota), usage(count, 0), available((count + 63) / 64, 0) {
+	reset();
+}
+
+// Round robin keeps the words spread over all fonts
+auto FontSlots::take() -> int {
+	int font = findFrom(cursor);
+	if (font == -1) {
+		font = findFrom(0);
+	}
+	if (font == -1) {
+		return -1;
+	}
+	if (++usage[font] == quota) {
+		setAvailable(font, false);
+	}
+	cursor = font + 1 == count ? 0 : font + 1;
+	return font;
+}
+
+auto FontSlots::release(const int font) -> void {
+	if (font < 0 || font >= count || usage[font] == 0) {
+		return;
+	}
+	usage[font]--;
+	setAvailable(font, true);
+}
+
+auto FontSlots::reset() -> void {
+	cursor = 0;
+	for (int font = 0; font < count; ++font) {
+		usage[font] = 0;
+		setAvailable(font, quota > 0);
+	}
+}
+
+auto FontSlots::uses(const int font) const -> int {
+	return usage[font];
+}
+
+auto FontSlots::size() const -> int {
+	return count;
+}
+
+auto FontSlots::setAvailable(const int font, const bool isAvailable) -> void {
+	const std::uint64_t bit = std::uint64_t{1} << (font % 64);
+	if (isAvailable) {
+		available[font / 64] |= bit;
+	} else {
+		available[font / 64] &= ~bit;
+	}
+}
+
+auto FontSlots::findFrom(const int font) const -> int {
+	if (font >= count) {
+		return -1;
+	}
+	// bits below font in its own word are masked off
+	std::size_t word = static_cast<std::size_t>(font / 64);
+	std::uint64_t bits = available[word] & (~std::uint64_t{0} << (font % 64));
+	while (bits == 0) {
+		if (++word == available.size()) {
+			return -1;
+		}
+		bits = available[word];
+	}
+	return static_cast<int>(word * 64) + std::countr_zero(bits);
+}
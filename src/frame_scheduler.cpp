@@ -0,0 +1,51 @@
+#include "frame_scheduler.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+	constexpr std::int64_t never = std::numeric_limits<std::int64_t>::max();
+	// event polling while animating and while idle, idle input waits at most this long
+	constexpr std::int64_t busyPollNs = 1'000'000;
+	constexpr std::int64_t idlePollNs = 10'000'000;
+}
+
+// constructor
+FrameScheduler::FrameScheduler(const int frameRate)
+	: frameNs(1'000'000'000 / std::max(frameRate, 1)), deadlineNs(never) {
+}
+
+auto FrameScheduler::beginFrame(const std::int64_t nowNs) -> void {
+	lastFrameNs = nowNs;
+	deadlineNs = never;
+	animating = false;
+	dirty = false;
+}
+
+auto FrameScheduler::animate() -> void {
+	animating = true;
+}
+
+auto FrameScheduler::invalidate() -> void {
+	dirty = true;
+}
+
+auto FrameScheduler::wakeAt(const std::int64_t atNs) -> void {
+	deadlineNs = std::min(deadlineNs, atNs);
+}
+
+// A deadline is drawn on time, input and animation wait for the frame rate
+auto FrameScheduler::due(const std::int64_t nowNs) const -> bool {
+	if (nowNs >= deadlineNs) {
+		return true;
+	}
+	return (animating || dirty) && nowNs - lastFrameNs >= frameNs;
+}
+
+auto FrameScheduler::sleepNs(const std::int64_t nowNs) const -> std::int64_t {
+	const std::int64_t untilDeadline = deadlineNs == never ? never : std::max<std::int64_t>(deadlineNs - nowNs, 0);
+	return std::min(idle() ? idlePollNs : busyPollNs, untilDeadline);
+}
+
+auto FrameScheduler::idle() const -> bool {
+	return !animating && !dirty;
+}
@@ -0,0 +1,62 @@
+#include "frame_snapshot.h"
+#include <algorithm>
+#include "game.h"
+
+auto FrameSnapshot::reserve(const std::size_t words) -> void {
+	x.reserve(words);
+	prevX.reserve(words);
+	y.reserve(words);
+	band.reserve(words);
+	fontIndex.reserve(words);
+	text.reserve(words);
+	matched.reserve(words);
+	input.reserve(64);
+}
+
+// Dead words are skipped, they are gone before the next tick anyway
+auto FrameSnapshot::capture(Game& game, const std::int64_t latestTickNs, const float latestTickDuration) -> void {
+	x.clear();
+	prevX.clear();
+	y.clear();
+	band.clear();
+	fontIndex.clear();
+	text.clear();
+	matched.clear();
+	const ActiveWords& words = game.activeWords;
+	for (std::size_t i = 0; i < words.size(); ++i) {
+		if (!words.alive[i]) {
+			continue;
+		}
+		x.push_back(words.x[i]);
+		prevX.push_back(words.prevX[i]);
+		y.push_back(words.y[i]);
+		band.push_back(words.band[i]);
+		fontIndex.push_back(words.fontIndex[i]);
+		text.push_back(words.text[i]);
+		matched.push_back(game.matchedLength(i));
+	}
+
+	input = game.getPlayerInput();
+	score = game.score;
+	lives = game.lives;
+	wpm = static_cast<int>(game.stats.wpm(latestTickNs));
+	accuracy = static_cast<int>(game.stats.accuracy() * 100.0);
+	over = game.isOver();
+	tickNs = latestTickNs;
+	tickDuration = latestTickDuration;
+}
+
+auto FrameSnapshot::size() const -> std::size_t {
+	return x.size();
+}
+
+auto FrameSnapshot::alpha(const std::int64_t nowNs) const -> float {
+	if (tickDuration <= 0.f) {
+		return 1.f;
+	}
+	return std::clamp(static_cast<float>(static_cast<double>(nowNs - tickNs) / 1e9 / tickDuration), 0.f, 1.f);
+}
+
+auto FrameSnapshot::interpolatedX(const std::size_t i, const float alpha) const -> float {
+	return prevX[i] + (x[i] - prevX[i]) * alpha;
+}
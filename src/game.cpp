@@ -1,257 +1,380 @@
 #include "../include/game.h"
-#include "window.h"
-#include <cmath>
-#include <fstream>
-#include <iostream>
-#include <random>
+#include "profiler.h"
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
+#include "checksum.h"
+#include "unicode.h"
 
-Game::Game(const std::string& wordsFilePath)
-	: currentFontIndex(0)
-{
-	words = loadWordsFromFile(wordsFilePath);
-	fonts = loadAllFonts();
+namespace {
+	// words enter with their right end at the left edge of the screen, in
+	// a vertical band split into lanes
+	constexpr float spawnEdge = 0.f;
+	constexpr float spawnTop = 100.f;
+	constexpr float spawnBottom = 550.f;
+	// the core does not know font metrics, this is about the advance of a
+	// glyph at the word character size, plus the gap kept between words
+	constexpr float estimatedCharWidth = 12.f;
+	constexpr float laneGap = 20.f;
+	// a word may be off by one edit per this many of its characters
+	constexpr std::size_t charsPerTypo = 3;
+
+	// Longer words move slower
+	auto wordSpeed(const std::size_t length) -> float {
+		return std::max(75.f - static_cast<float>(length) * 1.15f, 1.f);
+	}
+
+	auto wordWidth(const std::size_t length) -> float {
+		return static_cast<float>(length) * estimatedCharWidth;
+	}
+
+	auto loadDictionary(const std::string& path) -> Dictionary {
+		Dictionary dictionary;
+		dictionary.loadFromFile(path);
+		return dictionary;
+	}
+}
+
+auto GameLimits::stress(const std::size_t maxWords, const int fontCount) -> GameLimits {
+	GameLimits limits;
+	limits.maxActiveWords = maxWords;
+	limits.spawnInterval = 0.005f;
+	// just enough uses per font for every word to get one
+	const auto fonts = static_cast<std::size_t>(std::max(fontCount, 1));
+	limits.fontQuota = static_cast<int>((maxWords + fonts - 1) / fonts);
+	limits.laneHeight = 1.f;
+	limits.keepWordsApart = false;
+	limits.repeatWords = true;
+	limits.endless = true;
+	return limits;
+}
 
-	// Initialize font usage counters
-	fontUsageCount.resize(fonts.size(), 0);
+Game::Game(const std::string& wordsFilePath, const int fontCount, const float worldWidth, const GameLimits& limits)
+	: Game(loadDictionary(wordsFilePath), fontCount, worldWidth, limits) {}
 
+Game::Game(Dictionary words, const int fontCount, const float worldWidth, const GameLimits& limits)
+	: dictionary(std::move(words)), activeWords(limits.maxActiveWords), worldWidth(worldWidth), limits(limits),
+	  fonts(fontCount, limits.fontQuota), lanes(spawnTop, spawnBottom, limits.laneHeight), gen(randomSeed())
+{
 	// Initialize inactive words
 	initInactiveWords();
+
+	// every word on the screen needs at most one node per character
+	index.reserve(limits.maxActiveWords * dictionary.longestWord() + 1);
+	// typed graphemes are composed again without allocating
+	typedGrapheme.reserve(dictionary.longestWord() + 1);
+	composeScratch.reserve(dictionary.longestWord() + 1);
+
+	// time the fastest word needs from the spawn edge to the gap before the right edge
+	followerTime = (worldWidth - spawnEdge - laneGap) / wordSpeed(1);
 }
 
+// Fonts are taken round robin, each font is shared by at most fontQuota words
 auto Game::getNextFontIndex() -> int {
-	// Retrieve the next font with usage less than 7 times
-	// This ensures balanced distribution across fonts
-	for (int i = 0; static_cast<int>(fonts.size()); ++i) {
-		if (const int idx = currentFontIndex; fontUsageCount[idx] < 7) {
-			fontUsageCount[idx]++;
-			currentFontIndex = (currentFontIndex + 1) % static_cast<int>(fonts.size());
-			return idx;
+	return fonts.take();
+}
+
+auto Game::releaseFont(const int fontIndex) -> void {
+	fonts.release(fontIndex);
+}
+
+auto Game::fontCount() const -> int {
+	return fonts.size();
+}
+
+// Destroy the words equal to the typed input, the index already knows them
+auto Game::checkWordOnScreen() -> int {
+	// killing a word removes it from this list
+	const std::vector<WordHandle> &matches = index.exactMatches();
+	int destroyed = 0;
+	while (!matches.empty()) {
+		const std::size_t slot = activeWords.resolve(matches.back());
+		if (slot == ActiveWords::npos) {
+			break;
 		}
-		currentFontIndex = (currentFontIndex + 1) % static_cast<int>(fonts.size());
+		killWord(slot);
+		destroyed++;
 	}
-	// With a limit of 16 words, there shouldn't be a situation where no font is available,
-	// but returning -1 as a safeguard.
-	return -1;
+	// with typos forgiven an exact word is worth two points, a forgiven one a single point
+	if (limits.typoTolerance == 0) {
+		score += destroyed;
+	} else if (destroyed > 0) {
+		score += 2 * destroyed;
+	} else if (killClosestWord()) {
+		score += 1;
+		destroyed = 1;
+	}
+	index.clearInput();
+	return destroyed;
 }
 
-// Decrement font usage counter
-auto Game::releaseFont(const int fontIndex) -> void {
-	if (fontIndex >= 0 && fontIndex < static_cast<int>(fontUsageCount.size())) {
-		fontUsageCount[fontIndex]--;
-		if (fontUsageCount[fontIndex] < 0) {
-			fontUsageCount[fontIndex] = 0;
+// Without an exact match the word closest to the input is taken, when it is
+// within the tolerance. Of equally close words the one furthest right goes,
+// it is the next to cost a life.
+auto Game::killClosestWord() -> bool {
+	MONKE_PROFILE_SCOPE("typo match");
+	if (!typoMatcher.setPattern(index.typed())) {
+		return false;
+	}
+	std::size_t best = ActiveWords::npos;
+	int bestDistance = limits.typoTolerance;
+	for (std::size_t slot = 0; slot < activeWords.size(); ++slot) {
+		if (!activeWords.alive[slot]) {
+			continue;
+		}
+		const std::u32string_view word = activeWords.text[slot];
+		const int limit = std::min(bestDistance, static_cast<int>(word.size() / charsPerTypo));
+		const int distance = typoMatcher.distance(word, limit);
+		if (distance > limit) {
+			continue;
+		}
+		if (best == ActiveWords::npos || distance < bestDistance || activeWords.x[slot] > activeWords.x[best]) {
+			best = slot;
+			bestDistance = distance;
 		}
 	}
+	if (best == ActiveWords::npos) {
+		return false;
+	}
+	killWord(best);
+	return true;
+}
+
+// Mark word as dead, it is recycled at the end of the next tick
+auto Game::killWord(const std::size_t slot) -> void {
+	activeWords.kill(slot);
+	index.erase(activeWords.indexNode[slot], activeWords.handle[slot]);
+	activeWords.indexNode[slot] = -1;
+	lanes.leave(activeWords.lane[slot]);
+}
+
+// Initialize inactive words list, only word ids are kept
+auto Game::initInactiveWords() -> void {
+	inActiveWords.reset(dictionary.size());
+}
+
+// Choose how likely words are to spawn
+auto Game::setWordWeighting(const WordWeighting weighting) -> void {
+	if (weighting == WordWeighting::Uniform) {
+		inActiveWords.setWeights({});
+		return;
+	}
+	std::vector<float> weights(dictionary.size());
+	for (std::uint32_t id = 0; id < weights.size(); ++id) {
+		const auto length = static_cast<float>(dictionary[id].size());
+		switch (weighting) {
+			case WordWeighting::ShortWords:
+				weights[id] = 1.f / length;
+				break;
+			case WordWeighting::LongWords:
+				weights[id] = length;
+				break;
+			default:
+				weights[id] = dictionary.frequency(id);
+				break;
+		}
+	}
+	inActiveWords.setWeights(weights);
+}
+
+// Spawn a new word on the screen
+auto Game::spawnWord() -> bool {
+	MONKE_PROFILE_SCOPE("spawnWord");
+	// Limit the number of active words
+	if (activeWords.full() || inActiveWords.empty() || lanes.freeCount() == 0) {
+		return false;
+	}
+
+	// Get the next font index
+	const int fontIdx = getNextFontIndex();
+	if (fontIdx == -1) {
+		return false;
+	}
+
+	// Randomly select a word from the inactive words and remove it from inactive list,
+	// repeated words stay in the list
+	const std::uint32_t wordId = limits.repeatWords ? inActiveWords.sample(gen) : inActiveWords.take(gen);
+	const std::u32string_view word = dictionary[wordId];
+
+	// Adjust speed based on word length
+	const float speed = wordSpeed(word.size());
+
+	// the lane stays taken until the word moved its own width away from the
+	// edge, and for long enough that a faster word behind it can not catch
+	// up before it leaves the screen
+	const float width = wordWidth(word.size());
+	const float edgeTime = (width + laneGap) / speed;
+	const float exitTime = (worldWidth - spawnEdge + width) / speed;
+	const int lane = lanes.take(gen, limits.keepWordsApart ? std::max(edgeTime, exitTime - followerTime) : edgeTime);
+
+	// Add the word to the list of active words
+	const std::size_t slot = activeWords.add(word, wordId, fontIdx, spawnEdge - width, lanes.laneY(lane), speed, lane);
+	activeWords.indexNode[slot] = index.insert(word, activeWords.handle[slot]);
+	return true;
+}
+
+// Start a new round
+auto Game::reset() -> void {
+	score = 0;
+	lives = 6;
+	spawnTimer = 0.f;
+
+	// give back fonts of words still on the screen
+	fonts.reset();
+
+	// reset of active words and init of inactive words
+	activeWords.clear();
+	index.clear();
+	lanes.reset();
+	stats.reset();
+	initInactiveWords();
 }
 
-// Access font by index
-auto Game::getFont(const int index) -> Font& {
-	return fonts[index];
+auto Game::reset(const std::uint32_t seed) -> void {
+	gen.seed(seed);
+	reset();
 }
 
-// Function to load words from a file
-auto Game::loadWordsFromFile(const std::string& filePath) -> std::vector<std::string> {
-    std::vector<std::string> words;
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        std::cerr << "Cannot open words file: " << filePath << "\n";
-        return words;  // Return empty vector to avoid crashes
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        // Skip empty lines
-        if (!line.empty()) {
-            words.push_back(line);
-        }
-    }
-
-    return words;
+// Advance the simulation by dt seconds
+auto Game::tick(const float dt) -> void {
+	lanes.advance(dt);
+
+	// spawn for every spawnInterval, several per tick when the interval is shorter than dt
+	spawnTimer += dt;
+	while (limits.spawnInterval > 0.f && spawnTimer >= limits.spawnInterval) {
+		spawnWord();
+		spawnTimer -= limits.spawnInterval;
+	}
+
+	updateWords(dt);
+	recycleWords();
 }
 
-// Load all fonts into the program
-auto Game::loadAllFonts() -> std::vector<Font> {
-    std::vector<Font> fonts;
-    fonts.reserve(16);  // There are exactly 16 fonts
-
-    // Create font objects
-    Font openSans("OpenSans", "../assets/fonts/OpenSans.ttf");
-    Font antonsc("AntonSC", "../assets/fonts/AntonSC.ttf");
-    Font orangeKid("OrangeKid", "../assets/fonts/OrangeKid.ttf");
-    Font caveatsb("CaveatSB", "../assets/fonts/CaveatSB.ttf");
-    Font cbyg("CBYG", "../assets/fonts/CBYG.ttf");
-    Font ebgaramond("EBGaramond", "../assets/fonts/EBGaramond.ttf");
-    Font edu("Edu", "../assets/fonts/Edu.ttf");
-    Font indieFlower("IndieFlower", "../assets/fonts/IndieFlower.ttf");
-    Font lobster("Lobster", "../assets/fonts/Lobster.ttf");
-    Font mali("Mali", "../assets/fonts/Mali.ttf");
-    Font manslava("Mansalva", "../assets/fonts/Mansalva.ttf");
-    Font oswald("Oswald", "../assets/fonts/Oswald.ttf");
-    Font pacifico("Pacifico", "../assets/fonts/Pacifico.ttf");
-    Font permanentMarker("PermanentMarker", "../assets/fonts/PermanentMarker.ttf");
-    Font roboto("Roboto", "../assets/fonts/Roboto.ttf");
-    Font yujiMai("YujiMai", "../assets/fonts/YujiMai.ttf");
-
-    // Attempt to load each font file and log errors if loading fails
-    if (!openSans.load())          { std::cerr << "Failed to load OpenSans\n"; }
-    if (!antonsc.load())           { std::cerr << "Failed to load AntonSC\n"; }
-    if (!orangeKid.load())         { std::cerr << "Failed to load OrangeKid\n"; }
-    if (!caveatsb.load())          { std::cerr << "Failed to load CaveatSB\n"; }
-    if (!cbyg.load())              { std::cerr << "Failed to load CBYG\n"; }
-    if (!ebgaramond.load())        { std::cerr << "Failed to load EBGaramond\n"; }
-    if (!edu.load())               { std::cerr << "Failed to load Edu\n"; }
-    if (!indieFlower.load())       { std::cerr << "Failed to load IndieFlower\n"; }
-    if (!lobster.load())           { std::cerr << "Failed to load Lobster\n"; }
-    if (!mali.load())              { std::cerr << "Failed to load Mali\n"; }
-    if (!manslava.load())          { std::cerr << "Failed to load Mansalva\n"; }
-    if (!oswald.load())            { std::cerr << "Failed to load Oswald\n"; }
-    if (!pacifico.load())          { std::cerr << "Failed to load Pacifico\n"; }
-    if (!permanentMarker.load())   { std::cerr << "Failed to load PermanentMarker\n"; }
-    if (!roboto.load())            { std::cerr << "Failed to load Roboto\n"; }
-    if (!yujiMai.load())           { std::cerr << "Failed to load YujiMai\n"; }
-
-    // Add fonts to the vector even if some failed to load
-    fonts.push_back(openSans);
-    fonts.push_back(antonsc);
-    fonts.push_back(orangeKid);
-    fonts.push_back(caveatsb);
-    fonts.push_back(cbyg);
-    fonts.push_back(ebgaramond);
-    fonts.push_back(edu);
-    fonts.push_back(indieFlower);
-    fonts.push_back(lobster);
-    fonts.push_back(mali);
-    fonts.push_back(manslava);
-    fonts.push_back(oswald);
-    fonts.push_back(pacifico);
-    fonts.push_back(permanentMarker);
-    fonts.push_back(roboto);
-    fonts.push_back(yujiMai);
-
-    // Return the vector of fonts
-    return fonts;
+// Movement, color banding and life loss
+auto Game::updateWords(const float dt) -> void {
+	MONKE_PROFILE_SCOPE("update");
+	activeWords.integrate(dt);
+	// color change based on position
+	activeWords.classify(worldWidth * 0.5f, worldWidth * 0.75f);
+
+	// word goes out of screen = lose life
+	const std::size_t count = activeWords.size();
+	const float *xs = activeWords.x.data();
+	for (std::size_t i = 0; i < count; ++i) {
+		if (xs[i] > worldWidth && activeWords.alive[i]) {
+			killWord(i);
+			lives--;
+		}
+	}
 }
 
-// Update word position
-auto Game::GameWord::update(const float dt) -> void {
-	auto pos = sfText.getPosition();
-	pos.x += speedX * dt;
-	sfText.setPosition(pos);
+// Font recycling, dead words give back their font and word id
+auto Game::recycleWords() -> void {
+	MONKE_PROFILE_SCOPE("recycle");
+	for (const std::size_t slot : activeWords.dead()) {
+		releaseFont(activeWords.fontIndex[slot]);
+		inActiveWords.give(activeWords.wordId[slot]);
+	}
+	activeWords.removeDead();
 }
 
-// Check if the typed word matches any active word
-auto Game::checkWordOnScreen(const std::string &typedWord, std::vector<GameWord> &activeWords, Game &game) -> void {
-	for (auto &gw : activeWords) {
-		if (typedWord == gw.originalString) {
-			gw.isAlive = false;
-			game.releaseFont(gw.fontIndex);
+// Apply one typing event from the input queue
+auto Game::applyInput(const InputEvent &event) -> void {
+	switch (event.type) {
+		case InputEvent::Type::Char:
+			typeChar(event.character);
+			// a key is correct while some word still starts with the input
+			stats.recordKey(event.timestampNs, candidateCount() > 0);
+			break;
+		case InputEvent::Type::Backspace:
+			eraseChar();
+			stats.recordBackspace(event.timestampNs);
+			break;
+		case InputEvent::Type::Enter: {
+			const std::size_t length = getPlayerInput().size();
+			const int destroyed = checkWordOnScreen();
+			stats.recordEnter(event.timestampNs, length, destroyed > 0);
+			break;
 		}
 	}
 }
 
-// Initialize inactive words list
-auto Game::initInactiveWords() -> void {
-	// Clear any existing data
-	inActiveWords.clear();
-
-	for (const auto &w : words) {
-		// Create GameWord objects and set them as inactive
-		GameWord gw;
-		gw.originalString = w;
-		gw.isAlive = false;
-		gw.fontIndex = -1;
-		gw.speedX = 0.f;
-		inActiveWords.push_back(gw);
+// Typing a character narrows the candidate words. A mark may reorder or merge
+// with the character it follows, so the last grapheme is composed again the
+// way the words were when loaded, whatever order its marks were typed in.
+auto Game::typeChar(const char32_t c) -> void {
+	index.push(c);
+	if (!extendsGrapheme(c)) {
+		return;
+	}
+	const std::u32string& typed = index.typed();
+	const std::size_t start = lastGraphemeStart(typed);
+	typedGrapheme.assign(typed, start);
+	composeFrom(typedGrapheme, 0, composeScratch);
+	if (std::u32string_view(typed).substr(start) == typedGrapheme) {
+		return;
+	}
+	while (index.typed().size() > start) {
+		index.pop();
+	}
+	for (const char32_t composed : typedGrapheme) {
+		index.push(composed);
 	}
 }
 
-// Spawn a new word on the screen
-auto Game::spawnWord() -> void {
-    // Limit the number of active words to 16
-    if (activeWords.size() >= 16) {
-        std::cout << "Max 16 active words!\n";
-        return;
-    }
-
-    // No inactive words available
-    if (inActiveWords.empty()) {
-        std::cout << "All words are active!\n";
-        return;
-    }
-
-    // Randomly select a word from the inactive words
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    // Prepare candidate indices and shuffle
-    std::vector<size_t> candidates;
-    candidates.reserve(inActiveWords.size());
-    for (size_t i = 0; i < inActiveWords.size(); i++) {
-        candidates.push_back(i);
-    }
-    std::ranges::shuffle(candidates, gen);
-
-    // Select the first candidate
-	const size_t idx = candidates.front();
-
-	// Retrieve the word and remove it from inactive list
-    GameWord gw = inActiveWords[idx];
-	inActiveWords.erase(inActiveWords.begin() + static_cast<std::deque<GameWord>::difference_type>(idx));
-
-    // Get the next font index
-    const int fontIdx = getNextFontIndex();
-    if (fontIdx == -1) {
-        std::cout << "No more fonts available!\n";
-        inActiveWords.push_front(gw);
-        return;
-    }
-
-    // Set parameters for the word
-    gw.fontIndex = fontIdx;
-    gw.sfText.setFont(fonts[fontIdx].getSfFont());
-    gw.sfText.setCharacterSize(20);
-    gw.sfText.setString(gw.originalString);
-    gw.sfText.setFillColor(sf::Color::Green);
-    gw.isAlive = true;
-
-    // Adjust speed based on word length
-    const auto velDiff = static_cast<float>(gw.originalString.size()) * 1.15f;
-
-    gw.speedX = 75.f - velDiff; // Longer words move slower
-
-    // Generate a Y-position that avoids collision with other words
-    std::uniform_real_distribution<float> distY(100.f, 550.f);
-    bool foundY = false;
-    float spawnY{};
-	constexpr int maxTries = 20;
-    for (int i = 0; i < maxTries; i++) {
-		const float candidateY = distY(gen);
-        // Check for collisions with other active words
-        bool collision = false;
-        for (auto &aw : activeWords) {
-            if (const float dy = std::fabs(aw.sfText.getPosition().y - candidateY); dy < 15.f) {
-                collision = true;
-                break;
-            }
-        }
-        if (!collision) {
-            spawnY = candidateY;
-            foundY = true;
-            break;
-        }
-    }
-    if (!foundY) {
-        // If no valid Y-position is found after max tries
-        std::cout << "Cannot spawn due to Y-collision after 20 tries\n";
-        inActiveWords.push_front(gw); // Return word to inactive list
-        return;
-    }
-
-    // Set final X and Y positions for the word
-    gw.sfText.setPosition(-100.f, spawnY);
-
-    // Add the word to the list of active words
-    activeWords.push_back(gw);
+// Backspace widens the candidate words again, one whole user perceived character
+auto Game::eraseChar() -> void {
+	const std::size_t start = lastGraphemeStart(index.typed());
+	while (index.typed().size() > start) {
+		index.pop();
+	}
+}
+
+auto Game::getPlayerInput() const -> const std::u32string& {
+	return index.typed();
+}
+
+auto Game::candidateCount() const -> int {
+	return index.candidateCount();
+}
+
+auto Game::matchedLength(const std::size_t slot) const -> std::size_t {
+	return index.matchedLength(activeWords.indexNode[slot]);
+}
+
+// Type the whole word and press enter
+auto Game::submitWord(const std::u32string_view typedWord) -> int {
+	index.clearInput();
+	for (const char32_t c : typedWord) {
+		index.push(c);
+	}
+	return checkWordOnScreen();
+}
+
+auto Game::isOver() const -> bool {
+	return !limits.endless && lives <= 0;
+}
+
+// Positions are hashed bit for bit, a replay has to match exactly, not roughly
+auto Game::stateChecksum() const -> std::uint64_t {
+	Checksum sum;
+	sum.add(score);
+	sum.add(lives);
+	sum.add(spawnTimer);
+	sum.add(getPlayerInput());
+	sum.add(stats.keystrokes());
+	sum.add(stats.backspaces());
+	sum.add(stats.wordsHit());
+	sum.add(stats.wordsMissed());
+	sum.add(activeWords.size());
+	for (std::size_t i = 0; i < activeWords.size(); ++i) {
+		sum.add(activeWords.wordId[i]);
+		sum.add(activeWords.x[i]);
+		sum.add(activeWords.y[i]);
+		sum.add(activeWords.fontIndex[i]);
+		sum.add(activeWords.lane[i]);
+		sum.add(activeWords.band[i]);
+	}
+	return sum.value();
 }
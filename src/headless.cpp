@@ -0,0 +1,243 @@
+#include "headless.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "asset_pack.h"
+#include "session_record.h"
+
+namespace {
+	// live words of a stress run unless --max-words says otherwise
+	constexpr std::size_t defaultStressWords = 4000;
+
+	// words file given on the command line, else the pack or assets directory next to the executable,
+	// the pack has to outlive the words
+	auto loadWords(const HeadlessOptions& options, AssetPack& pack, Dictionary& words) -> void {
+		const std::filesystem::path executableDir = executableDirectory();
+		if (!options.wordsFilePath.empty()) {
+			words.loadFromFile(options.wordsFilePath);
+		} else if (pack.open((executableDir / "monke.pak").string()) && pack.find("words.txt")) {
+			words.loadFromMemory(*pack.find("words.txt"));
+		} else {
+			words.loadFromFile((executableDir / ".." / "assets" / "words.txt").string());
+		}
+	}
+
+	// slot of the living word furthest right, the next one to cost a life,
+	// slots are reordered by removals so the first one is not the oldest
+	auto closestToEdge(const ActiveWords& words) -> std::size_t {
+		std::size_t best = 0;
+		for (std::size_t slot = 1; slot < words.size(); ++slot) {
+			if (words.alive[slot] && (!words.alive[best] || words.x[slot] > words.x[best])) {
+				best = slot;
+			}
+		}
+		return best;
+	}
+}
+
+// Parse "--ticks", "--dt", "--words", "--type-every", "--weighting", "--seed", "--replay" and the limit arguments
+auto parseHeadlessOptions(const int argc, char* argv[], HeadlessOptions& options) -> bool {
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "--headless") {
+			continue;
+		}
+		if (arg == "--stress") {
+			options.limits.stress = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			std::cerr << "Missing value for argument " << arg << "\n";
+			return false;
+		}
+		const std::string value = argv[++i];
+		try {
+			if (arg == "--ticks") {
+				options.ticks = std::stoll(value);
+			} else if (arg == "--dt") {
+				options.dt = std::stof(value);
+			} else if (arg == "--words") {
+				options.wordsFilePath = value;
+			} else if (arg == "--type-every") {
+				options.typeEvery = std::stoi(value);
+			} else if (arg == "--weighting") {
+				if (value == "uniform") {
+					options.weighting = WordWeighting::Uniform;
+				} else if (value == "short") {
+					options.weighting = WordWeighting::ShortWords;
+				} else if (value == "long") {
+					options.weighting = WordWeighting::LongWords;
+				} else if (value == "frequency") {
+					options.weighting = WordWeighting::Frequency;
+				} else {
+					throw std::invalid_argument(value);
+				}
+			} else if (arg == "--seed") {
+				options.seed = static_cast<std::uint32_t>(std::stoul(value));
+			} else if (arg == "--replay") {
+				options.replayPath = value;
+			} else if (!parseLimitOption(arg, value, options.limits)) {
+				std::cerr << "Unknown argument " << arg << "\n";
+				return false;
+			}
+		} catch (const std::exception&) {
+			std::cerr << "Invalid value '" << value << "' for argument " << arg << "\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+auto parseLimitOption(const std::string& arg, const std::string& value, LimitOptions& options) -> bool {
+	if (arg == "--max-words") {
+		options.maxWords = std::stoul(value);
+	} else if (arg == "--spawn-interval") {
+		options.spawnInterval = std::stof(value);
+	} else if (arg == "--font-quota") {
+		options.fontQuota = std::stoi(value);
+	} else if (arg == "--typos") {
+		options.typoTolerance = std::max(0, std::stoi(value));
+	} else {
+		return false;
+	}
+	return true;
+}
+
+auto resolveLimits(const LimitOptions& options, const int fontCount) -> GameLimits {
+	GameLimits limits = options.stress
+		? GameLimits::stress(options.maxWords > 0 ? options.maxWords : defaultStressWords, fontCount)
+		: GameLimits{};
+	if (options.maxWords > 0) {
+		limits.maxActiveWords = options.maxWords;
+	}
+	if (options.spawnInterval > 0.f) {
+		limits.spawnInterval = options.spawnInterval;
+	}
+	if (options.fontQuota > 0) {
+		limits.fontQuota = options.fontQuota;
+	}
+	limits.typoTolerance = options.typoTolerance;
+	return limits;
+}
+
+auto shippedFontCount(AssetPack& pack) -> int {
+	const std::filesystem::path executableDir = executableDirectory();
+	if (!pack.isOpen()) {
+		pack.open((executableDir / "monke.pak").string());
+	}
+	const auto count = static_cast<int>(fontAssetNames(pack, executableDir / ".." / "assets").size());
+	if (count == 0) {
+		std::cerr << "No fonts found next to the executable, running with one\n";
+		return 1;
+	}
+	return count;
+}
+
+// Tick the simulation with a fixed dt, a simple bot types the word closest to the right edge
+auto runHeadless(const HeadlessOptions& options) -> int {
+	if (!options.replayPath.empty()) {
+		return runReplay(options);
+	}
+	AssetPack pack;
+	Dictionary words;
+	loadWords(options, pack, words);
+	const int fontCount = options.fontCount > 0 ? options.fontCount : shippedFontCount(pack);
+	Game game(std::move(words), fontCount, options.worldWidth, resolveLimits(options.limits, fontCount));
+	if (game.dictionary.empty()) {
+		std::cerr << "No words loaded, headless run aborted\n";
+		return 1;
+	}
+	game.setWordWeighting(options.weighting);
+	// later rounds go on with the same engine, so the whole run follows from this seed
+	const std::uint32_t seed = options.seed.value_or(randomSeed());
+	game.reset(seed);
+
+	long long rounds = 1;
+	long long typedWords = 0;
+	long long totalScore = 0;
+	std::size_t peakWords = 0;
+	const auto start = std::chrono::steady_clock::now();
+
+	for (long long tick = 0; tick < options.ticks; ++tick) {
+		game.tick(options.dt);
+		peakWords = std::max(peakWords, game.activeWords.size());
+
+		// bot typing, the whole word in one tick through the same path as real keys,
+		// with typos forgiven it leaves off the last letter of every other word it types
+		if (options.typeEvery > 0 && tick % options.typeEvery == 0 && !game.activeWords.empty()) {
+			std::u32string_view word = game.activeWords.text[closestToEdge(game.activeWords)];
+			if (options.limits.typoTolerance > 0 && typedWords++ % 2 == 1) {
+				word.remove_suffix(1);
+			}
+			const std::int64_t timestampNs = static_cast<std::int64_t>(static_cast<double>(tick) * options.dt * 1e9);
+			for (const char32_t c : word) {
+				game.applyInput({InputEvent::Type::Char, c, timestampNs});
+			}
+			game.applyInput({InputEvent::Type::Enter, 0, timestampNs});
+		}
+
+		// start next round when the game is over
+		if (game.isOver()) {
+			totalScore += game.score;
+			game.reset();
+			rounds++;
+		}
+	}
+	totalScore += game.score;
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	const double seconds = elapsed.count();
+	std::cout << "Headless run: " << options.ticks << " ticks in " << seconds << " s ("
+			  << (seconds > 0.0 ? static_cast<double>(options.ticks) / seconds : 0.0) << " ticks/s), "
+			  << rounds << " rounds, total score " << totalScore << ", peak " << peakWords << " words, seed " << seed << "\n";
+	return 0;
+}
+
+// Events are applied before the tick they were applied before when recorded, then the ticks run back to back
+auto runReplay(const HeadlessOptions& options) -> int {
+	SessionRecording recording;
+	if (!recording.load(options.replayPath)) {
+		return 1;
+	}
+	const SessionHeader& header = recording.header;
+	AssetPack pack;
+	Dictionary words;
+	loadWords(options, pack, words);
+	if (words.checksum() != header.dictionaryChecksum) {
+		std::cerr << "Recording " << options.replayPath << " was made with different words, replay aborted\n";
+		return 1;
+	}
+	Game game(std::move(words), header.fontCount, header.worldWidth, header.limits);
+	game.reset(header.seed);
+
+	std::size_t next = 0;
+	auto slowestTick = std::chrono::steady_clock::duration::zero();
+	const auto start = std::chrono::steady_clock::now();
+	for (std::uint64_t tick = 0; tick <= recording.tickCount; ++tick) {
+		for (; next < recording.inputs.size() && recording.inputs[next].tick == tick; ++next) {
+			game.applyInput(recording.inputs[next].event);
+		}
+		if (tick == recording.tickCount) {
+			break;
+		}
+		const auto tickStart = std::chrono::steady_clock::now();
+		game.tick(header.tickDuration);
+		slowestTick = std::max(slowestTick, std::chrono::steady_clock::now() - tickStart);
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	const std::chrono::duration<double, std::milli> slowest = slowestTick;
+
+	const std::uint64_t checksum = game.stateChecksum();
+	const bool match = checksum == recording.finalChecksum;
+	const double seconds = elapsed.count();
+	std::cout << "Replay: " << recording.tickCount << " ticks, " << recording.inputs.size() << " events in " << seconds << " s ("
+			  << (seconds > 0.0 ? static_cast<double>(recording.tickCount) / seconds : 0.0) << " ticks/s), slowest tick "
+			  << slowest.count() << " ms, score " << game.score << ", checksum " << std::hex << checksum << std::dec
+			  << (match ? " matches the recording\n" : " does not match the recording\n");
+	return match ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include "hud.h"
+#include <charconv>
+#include <utility>
+
+// constructor
+HudCounter::HudCounter(std::string label, const sf::Font &font, const unsigned characterSize, const sf::Vector2f position)
+	: label(std::move(label)), text("", font, characterSize), value(0) {
+	text.setFillColor(sf::Color::White);
+	text.setPosition(position);
+}
+
+// Formatting into a reused buffer, sf::Text is only touched on change
+auto HudCounter::set(const int newValue) -> void {
+	if (hasValue && newValue == value) {
+		return;
+	}
+	value = newValue;
+	hasValue = true;
+
+	char digits[16];
+	const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+	buffer.assign(label);
+	buffer.append(digits, end);
+	text.setString(buffer);
+}
+
+auto HudCounter::draw(sf::RenderTarget &target) const -> void {
+	target.draw(text);
+}
+
+// constructor
+Hud::Hud(const sf::Font &font, const sf::Vector2u size)
+	: size(size),
+	  scoreCounter("Score: ", font, 20, {20.f, 20.f}),
+	  livesCounter("Lives: ", font, 20, {20.f, 50.f}),
+	  wpmCounter("WPM: ", font, 20, {20.f, 80.f}),
+	  accuracyCounter("Accuracy %: ", font, 20, {20.f, 110.f}),
+	  inputText("", font, 30) {
+	inputText.setFillColor(sf::Color::White);
+	inputText.setPosition(static_cast<float>(size.x) / 2.f, static_cast<float>(size.y) - 50.f);
+
+	// Shortcut instructions, stacked from the bottom right corner upwards
+	for (const char* line : {"Volume up      (+)", "Volume down  (-)", "Mute               (/)",
+							 "Volume Max   (*)", "Pause        (CTRL)", "Exit             (ESC)"}) {
+		shortcuts.emplace_back(line, font, 15);
+		shortcuts.back().setFillColor(sf::Color::White);
+	}
+	const float x = static_cast<float>(size.x) - shortcuts.front().getLocalBounds().width - 10.f;
+	float y = static_cast<float>(size.y) - 10.f - shortcuts.front().getLocalBounds().height;
+	shortcuts.front().setPosition(x, y);
+	for (std::size_t i = 1; i < shortcuts.size(); ++i) {
+		y -= shortcuts[i].getLocalBounds().height + 5.f;
+		shortcuts[i].setPosition(x, y);
+	}
+
+	composeOverlay();
+}
+
+// Static texts are drawn once, later frames draw one textured quad
+auto Hud::composeOverlay() -> void {
+	if (!overlay.create(size.x, size.y)) {
+		// no render texture support, texts are drawn one by one
+		return;
+	}
+	overlay.clear(sf::Color::Transparent);
+	for (const auto &text : shortcuts) {
+		overlay.draw(text);
+	}
+	overlay.display();
+	overlaySprite.setTexture(overlay.getTexture(), true);
+	overlayReady = true;
+}
+
+auto Hud::setScore(const int score) -> void {
+	scoreCounter.set(score);
+}
+
+auto Hud::setLives(const int lives) -> void {
+	livesCounter.set(lives);
+}
+
+auto Hud::setWpm(const int wpm) -> void {
+	wpmCounter.set(wpm);
+}
+
+auto Hud::setAccuracy(const int percent) -> void {
+	accuracyCounter.set(percent);
+}
+
+// Input is re-laid out only when it changed
+auto Hud::setInput(const std::u32string &newInput) -> void {
+	if (newInput == input) {
+		return;
+	}
+	input.assign(newInput);
+	inputText.setString(sf::String::fromUtf32(input.begin(), input.end()));
+	const float textWidth = inputText.getLocalBounds().width;
+	inputText.setPosition((static_cast<float>(size.x) - textWidth) / 2.f, static_cast<float>(size.y) - 50.f);
+}
+
+auto Hud::drawShortcuts(sf::RenderTarget &target) const -> void {
+	if (overlayReady) {
+		// text blended onto transparent pixels holds colour already multiplied by
+		// its alpha, blending it by alpha again would darken the glyph edges
+		target.draw(overlaySprite, sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+		return;
+	}
+	for (const auto &text : shortcuts) {
+		target.draw(text);
+	}
+}
+
+auto Hud::drawPlaying(sf::RenderTarget &target) const -> void {
+	target.draw(inputText);
+	scoreCounter.draw(target);
+	livesCounter.draw(target);
+	wpmCounter.draw(target);
+	accuracyCounter.draw(target);
+}
@@ -0,0 +1,37 @@
+#include "input.h"
+#include <algorithm>
+#include <chrono>
+#include "game.h"
+#include "session_record.h"
+
+auto InputLatency::record(const std::int64_t latencyNs) -> void {
+	count++;
+	totalNs += latencyNs;
+	maxNs = std::max(maxNs, latencyNs);
+}
+
+auto InputLatency::meanMs() const -> double {
+	return count > 0 ? static_cast<double>(totalNs) / static_cast<double>(count) / 1e6 : 0.0;
+}
+
+auto InputLatency::maxMs() const -> double {
+	return static_cast<double>(maxNs) / 1e6;
+}
+
+auto nowNs() -> std::int64_t {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Events newer than untilNs stay queued for a later tick
+auto drainInput(InputQueue &queue, Game &game, const std::int64_t untilNs, InputLatency &latency,
+				SessionRecorder *recorder) -> void {
+	for (const InputEvent* event = queue.front(); event != nullptr && event->timestampNs <= untilNs; event = queue.front()) {
+		game.applyInput(*event);
+		if (recorder != nullptr) {
+			recorder->input(*event);
+		}
+		latency.record(nowNs() - event->timestampNs);
+		queue.pop();
+	}
+}
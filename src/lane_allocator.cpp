@@ -0,0 +1,93 @@
+#include "lane_allocator.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+LaneAllocator::LaneAllocator(const float top, const float bottom, const float laneHeight)
+	: top(top), laneHeight(laneHeight)
+{
+	// bottom is the lowest lane top
+	const int count = std::max(1, static_cast<int>(std::floor((bottom - top) / laneHeight)) + 1);
+	positions.resize(count, absent);
+	tokens.resize(count, 0);
+	occupants.resize(count, 0);
+	freeLanes.reserve(count);
+	// room for a few timers per lane, the heap only grows until it saw the busiest stretch
+	std::vector<Pending> storage;
+	storage.reserve(static_cast<std::size_t>(count) * 4);
+	pending = decltype(pending)(std::greater<>{}, std::move(storage));
+	reset();
+}
+
+auto LaneAllocator::reset() -> void {
+	now = 0.0;
+	// popping keeps the heap storage
+	while (!pending.empty()) {
+		pending.pop();
+	}
+	freeLanes.clear();
+	std::ranges::fill(positions, absent);
+	std::ranges::fill(occupants, 0);
+	for (int lane = 0; lane < laneCount(); ++lane) {
+		tokens[lane]++;
+		free(lane);
+	}
+}
+
+// Free lanes whose timer ran out, entries of released lanes are skipped
+auto LaneAllocator::advance(const float dt) -> void {
+	now += dt;
+	while (!pending.empty() && pending.top().clearAt <= now) {
+		const Pending entry = pending.top();
+		pending.pop();
+		if (tokens[entry.lane] == entry.token) {
+			free(entry.lane);
+		}
+	}
+}
+
+// Swap the picked lane with the last free lane and pop
+auto LaneAllocator::take(RandomEngine &gen, const float clearTime) -> int {
+	if (freeLanes.empty()) {
+		return -1;
+	}
+	const std::size_t pos = uniformBelow(gen, static_cast<std::uint32_t>(freeLanes.size()));
+	const int lane = freeLanes[pos];
+	const int last = freeLanes.back();
+	freeLanes[pos] = last;
+	positions[last] = static_cast<int>(pos);
+	freeLanes.pop_back();
+	positions[lane] = absent;
+
+	occupants[lane]++;
+	pending.push({now + clearTime, lane, ++tokens[lane]});
+	return lane;
+}
+
+// Invalidate the pending timer, an empty lane is free right away
+auto LaneAllocator::leave(const int lane) -> void {
+	if (lane < 0 || lane >= laneCount() || occupants[lane] == 0) {
+		return;
+	}
+	if (--occupants[lane] == 0 && positions[lane] == absent) {
+		tokens[lane]++;
+		free(lane);
+	}
+}
+
+auto LaneAllocator::free(const int lane) -> void {
+	positions[lane] = static_cast<int>(freeLanes.size());
+	freeLanes.push_back(lane);
+}
+
+auto LaneAllocator::laneY(const int lane) const -> float {
+	return top + static_cast<float>(lane) * laneHeight;
+}
+
+auto LaneAllocator::laneCount() const -> int {
+	return static_cast<int>(positions.size());
+}
+
+auto LaneAllocator::freeCount() const -> int {
+	return static_cast<int>(freeLanes.size());
+}
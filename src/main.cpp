@@ -1,6 +1,56 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "asset_pack.h"
+#include "headless.h"
 #include "window.h"
 
-int main() {
-    Window app(1280, 720, "MonkeTyper", 60);
+int main(int argc, char* argv[]) {
+    // run the simulation without a window
+    if (argc > 1 && std::string(argv[1]) == "--headless") {
+        HeadlessOptions options;
+        if (!parseHeadlessOptions(argc, argv, options)) {
+            return 1;
+        }
+        return runHeadless(options);
+    }
+
+    // simulation tick rate, independent of the 60 FPS frame limit
+    int tickRate = 120;
+    // endurance mode and caps, the same overrides as the headless run
+    LimitOptions limitOptions;
+    // file every round is recorded into, for replay with --headless --replay
+    std::string recordPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--stress") {
+            limitOptions.stress = true;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                limitOptions.maxWords = static_cast<std::size_t>(std::atoi(argv[++i]));
+            }
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (i + 1 < argc) {
+            try {
+                if (parseLimitOption(arg, argv[i + 1], limitOptions)) {
+                    ++i;
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Invalid value '" << argv[i + 1] << "' for argument " << arg << "\n";
+                return 1;
+            }
+        }
+    }
+
+    // stress quotas are spread over the fonts the window is going to load
+    AssetPack pack;
+    const GameLimits limits = resolveLimits(limitOptions, limitOptions.stress ? shippedFontCount(pack) : 1);
+
+    Window app(1280, 720, "MonkeTyper", 60, tickRate, limits, recordPath);
     app.run();
 }
@@ -0,0 +1,148 @@
+#include "mapped_file.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+	*this = std::move(other);
+}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+	if (this != &other) {
+		close();
+		mapped = std::exchange(other.mapped, nullptr);
+		length = std::exchange(other.length, 0);
+#ifdef _WIN32
+		fileHandle = std::exchange(other.fileHandle, nullptr);
+		mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+
+auto MappedFile::open(const std::string& path) -> bool {
+	close();
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+							  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	length = static_cast<std::size_t>(fileSize.QuadPart);
+	// empty files cannot be mapped, they are simply open with no data
+	if (length == 0) {
+		return true;
+	}
+	mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		close();
+		return false;
+	}
+	mapped = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (mapped == nullptr) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+auto MappedFile::close() -> void {
+	if (mapped != nullptr) {
+		UnmapViewOfFile(mapped);
+	}
+	if (mappingHandle != nullptr) {
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle != nullptr) {
+		CloseHandle(fileHandle);
+	}
+	mapped = nullptr;
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+	length = 0;
+}
+
+auto MappedFile::isOpen() const -> bool {
+	return fileHandle != nullptr;
+}
+
+#else
+
+// empty files cannot be mapped, they point at this instead
+static constexpr char emptyFile[1] = {};
+
+auto MappedFile::open(const std::string& path) -> bool {
+	close();
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1) {
+		return false;
+	}
+	struct stat info{};
+	if (fstat(fd, &info) == -1) {
+		::close(fd);
+		return false;
+	}
+	length = static_cast<std::size_t>(info.st_size);
+	if (length == 0) {
+		::close(fd);
+		mapped = emptyFile;
+		return true;
+	}
+	void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping keeps the file alive
+	::close(fd);
+	if (address == MAP_FAILED) {
+		length = 0;
+		return false;
+	}
+	// the whole file is read right away, start reading ahead
+	madvise(address, length, MADV_WILLNEED);
+	mapped = static_cast<const char*>(address);
+	return true;
+}
+
+auto MappedFile::close() -> void {
+	if (mapped != nullptr && mapped != emptyFile) {
+		munmap(const_cast<char*>(mapped), length);
+	}
+	mapped = nullptr;
+	length = 0;
+}
+
+auto MappedFile::isOpen() const -> bool {
+	return mapped != nullptr;
+}
+
+#endif
+
+auto MappedFile::data() const -> const char* {
+	return mapped;
+}
+
+auto MappedFile::size() const -> std::size_t {
+	return length;
+}
+
+auto MappedFile::view() const -> std::string_view {
+	return {mapped, length};
+}
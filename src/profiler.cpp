@@ -0,0 +1,174 @@
+#include "profiler.h"
+
+#ifdef MONKE_PROFILING
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include "alloc_counter.h"
+#include "input.h"
+
+namespace {
+	// a profiler holds its whole frame history, far too much to give every thread up front
+	thread_local std::unique_ptr<Profiler> threadProfiler;
+}
+
+auto Profiler::instance() -> Profiler& {
+	if (threadProfiler == nullptr) {
+		threadProfiler = std::make_unique<Profiler>();
+	}
+	return *threadProfiler;
+}
+
+auto Profiler::current() -> Profiler* {
+	return threadProfiler.get();
+}
+
+auto Profiler::beginFrame() -> void {
+	const std::int64_t now = nowNs();
+	const std::uint64_t allocations = heapAllocations();
+	if (frameOpen) {
+		frames[next].durationNs = now - frames[next].startNs;
+		frames[next].allocations = allocations - frameStartAllocations;
+		next = (next + 1) % maxFrames;
+		// the slot of the running frame is not part of the history
+		finished = std::min(finished + 1, maxFrames - 1);
+	}
+	frames[next].startNs = now;
+	frames[next].durationNs = 0;
+	frames[next].stageCount = 0;
+	frames[next].allocations = 0;
+	frameStartAllocations = allocations;
+	frameOpen = true;
+	depth = 0;
+}
+
+// Stages beyond the per-frame limit are not recorded
+auto Profiler::beginStage(const char* name) -> std::size_t {
+	Frame &frame = frames[next];
+	if (!frameOpen || frame.stageCount == maxStagesPerFrame) {
+		return noSlot;
+	}
+	frame.stages[frame.stageCount] = {name, nowNs(), 0, depth++};
+	return frame.stageCount++;
+}
+
+auto Profiler::endStage(const std::size_t slot) -> void {
+	if (slot == noSlot) {
+		return;
+	}
+	Stage &stage = frames[next].stages[slot];
+	stage.durationNs = nowNs() - stage.startNs;
+	depth--;
+}
+
+auto Profiler::frameCount() const -> std::size_t {
+	return finished;
+}
+
+auto Profiler::frame(const std::size_t i) const -> const Frame& {
+	return frames[(next + maxFrames - finished + i) % maxFrames];
+}
+
+auto Profiler::frameTimePercentileMs(const double p) -> double {
+	if (finished == 0) {
+		return 0.0;
+	}
+	for (std::size_t i = 0; i < finished; ++i) {
+		scratch[i] = frame(i).durationNs;
+	}
+	const auto nth = static_cast<std::size_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(finished - 1));
+	std::nth_element(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(nth), scratch.begin() + static_cast<std::ptrdiff_t>(finished));
+	return static_cast<double>(scratch[nth]) / 1e6;
+}
+
+auto Profiler::maxFrameTimeMs() const -> double {
+	std::int64_t maxNs = 0;
+	for (std::size_t i = 0; i < finished; ++i) {
+		maxNs = std::max(maxNs, frame(i).durationNs);
+	}
+	return static_cast<double>(maxNs) / 1e6;
+}
+
+auto Profiler::stageMeanMs(const char* name) const -> double {
+	if (finished == 0) {
+		return 0.0;
+	}
+	std::int64_t totalNs = 0;
+	for (std::size_t i = 0; i < finished; ++i) {
+		const Frame &f = frame(i);
+		for (std::size_t s = 0; s < f.stageCount; ++s) {
+			if (std::strcmp(f.stages[s].name, name) == 0) {
+				totalNs += f.stages[s].durationNs;
+			}
+		}
+	}
+	return static_cast<double>(totalNs) / static_cast<double>(finished) / 1e6;
+}
+
+auto Profiler::meanAllocations() const -> double {
+	if (finished == 0) {
+		return 0.0;
+	}
+	std::uint64_t total = 0;
+	for (std::size_t i = 0; i < finished; ++i) {
+		total += frame(i).allocations;
+	}
+	return static_cast<double>(total) / static_cast<double>(finished);
+}
+
+auto Profiler::maxAllocations() const -> std::uint64_t {
+	std::uint64_t most = 0;
+	for (std::size_t i = 0; i < finished; ++i) {
+		most = std::max(most, frame(i).allocations);
+	}
+	return most;
+}
+
+// Complete events ("ph":"X"), times in microseconds relative to the first frame
+auto Profiler::exportChromeTrace(const std::string &path) const -> bool {
+	std::ofstream out(path);
+	if (!out) {
+		return false;
+	}
+	const std::int64_t originNs = finished > 0 ? frame(0).startNs : 0;
+	const auto us = [originNs](const std::int64_t ns) { return static_cast<double>(ns - originNs) / 1e3; };
+
+	out << "{\"traceEvents\":[\n";
+	bool first = true;
+	for (std::size_t i = 0; i < finished; ++i) {
+		const Frame &f = frame(i);
+		out << (first ? "" : ",\n") << R"({"name":"frame","ph":"X","pid":1,"tid":1,"ts":)" << us(f.startNs)
+			<< ",\"dur\":" << static_cast<double>(f.durationNs) / 1e3 << R"(,"args":{"allocations":)" << f.allocations << "}}";
+		first = false;
+		for (std::size_t s = 0; s < f.stageCount; ++s) {
+			const Stage &stage = f.stages[s];
+			out << ",\n" << R"({"name":")" << stage.name << R"(","ph":"X","pid":1,"tid":1,"ts":)" << us(stage.startNs)
+				<< ",\"dur\":" << static_cast<double>(stage.durationNs) / 1e3 << "}";
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return static_cast<bool>(out);
+}
+
+auto Profiler::exportCsv(const std::string &path) const -> bool {
+	std::ofstream out(path);
+	if (!out) {
+		return false;
+	}
+	out << "frame,stage,depth,start_us,duration_us\n";
+	const std::int64_t originNs = finished > 0 ? frame(0).startNs : 0;
+	for (std::size_t i = 0; i < finished; ++i) {
+		const Frame &f = frame(i);
+		out << i << ",frame,0," << static_cast<double>(f.startNs - originNs) / 1e3 << "," << static_cast<double>(f.durationNs) / 1e3 << "\n";
+		for (std::size_t s = 0; s < f.stageCount; ++s) {
+			const Stage &stage = f.stages[s];
+			out << i << "," << stage.name << "," << stage.depth + 1 << "," << static_cast<double>(stage.startNs - originNs) / 1e3
+				<< "," << static_cast<double>(stage.durationNs) / 1e3 << "\n";
+		}
+	}
+	return static_cast<bool>(out);
+}
+
+#endif // MONKE_PROFILING
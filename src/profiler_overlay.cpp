@@ -0,0 +1,57 @@
+#include "profiler_overlay.h"
+
+#ifdef MONKE_PROFILING
+
+#include <cstdio>
+#include <iostream>
+#include <utility>
+#include "profiler.h"
+
+// constructor
+ProfilerOverlay::ProfilerOverlay(const sf::Font &font, std::vector<const char*> stageNames)
+	: stageNames(std::move(stageNames)), text("", font, 15) {
+	text.setFillColor(sf::Color::Cyan);
+	text.setPosition(1000.f, 20.f);
+}
+
+auto ProfilerOverlay::toggle() -> void {
+	visible = !visible;
+}
+
+auto ProfilerOverlay::isVisible() const -> bool {
+	return visible;
+}
+
+auto ProfilerOverlay::exportFrames() const -> void {
+	const Profiler &profiler = Profiler::instance();
+	if (profiler.exportChromeTrace("monke_trace.json") && profiler.exportCsv("monke_trace.csv")) {
+		std::cout << "Exported " << profiler.frameCount() << " frames to monke_trace.json and monke_trace.csv\n";
+	} else {
+		std::cout << "Failed to export profiler frames\n";
+	}
+}
+
+auto ProfilerOverlay::draw(sf::RenderTarget &target) -> void {
+	if (!visible) {
+		return;
+	}
+	if (buffer.empty() || refreshClock.getElapsedTime() >= sf::milliseconds(250)) {
+		refreshClock.restart();
+		Profiler &profiler = Profiler::instance();
+		char line[96];
+		std::snprintf(line, sizeof(line), "frame p50 %.2f  p99 %.2f  max %.2f ms\n",
+					  profiler.frameTimePercentileMs(0.5), profiler.frameTimePercentileMs(0.99), profiler.maxFrameTimeMs());
+		buffer.assign(line);
+		std::snprintf(line, sizeof(line), "allocs/frame %.1f  max %llu\n",
+					  profiler.meanAllocations(), static_cast<unsigned long long>(profiler.maxAllocations()));
+		buffer.append(line);
+		for (const char* name : stageNames) {
+			std::snprintf(line, sizeof(line), "%-12s %.3f ms\n", name, profiler.stageMeanMs(name));
+			buffer.append(line);
+		}
+		text.setString(buffer);
+	}
+	target.draw(text);
+}
+
+#endif // MONKE_PROFILING
@@ -0,0 +1,37 @@
+#include "rng.h"
+#include <bit>
+
+auto randomSeed() -> std::uint32_t {
+	return std::random_device{}();
+}
+
+// Lemire's multiply and shift, the few low products that would favour some
+// results are rejected, so the draw is exactly uniform
+auto uniformBelow(RandomEngine& gen, const std::uint32_t bound) -> std::uint32_t {
+	std::uint64_t product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(gen())) * bound;
+	auto low = static_cast<std::uint32_t>(product);
+	if (low < bound) {
+		const std::uint32_t threshold = (0u - bound) % bound;
+		while (low < threshold) {
+			product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(gen())) * bound;
+			low = static_cast<std::uint32_t>(product);
+		}
+	}
+	return static_cast<std::uint32_t>(product >> 32);
+}
+
+// Draws masked to the bit width of bound are rejected until one is below it,
+// fewer than two tries on average
+auto uniformBelow64(RandomEngine& gen, const std::uint64_t bound) -> std::uint64_t {
+	const std::uint64_t mask = std::bit_ceil(bound) - 1;
+	std::uint64_t value;
+	do {
+		value = static_cast<std::uint64_t>(static_cast<std::uint32_t>(gen())) << 32;
+		value = (value | static_cast<std::uint32_t>(gen())) & mask;
+	} while (value >= bound);
+	return value;
+}
+
+auto uniformUnit(RandomEngine& gen) -> float {
+	return static_cast<float>(static_cast<std::uint32_t>(gen()) >> 8) * 0x1p-24f;
+}
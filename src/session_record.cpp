@@ -0,0 +1,231 @@
+#include "session_record.h"
+#include <bit>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string_view>
+
+namespace {
+	constexpr std::string_view magic = "MONKEREC";
+	constexpr std::uint32_t version = 3; // 2: characters are code points, 3: typo tolerance
+	constexpr std::size_t reservedEventBytes = 1 << 20;
+
+	// flags of GameLimits, one bit each
+	constexpr std::uint8_t keepWordsApartFlag = 1;
+	constexpr std::uint8_t repeatWordsFlag = 2;
+	constexpr std::uint8_t endlessFlag = 4;
+
+	// byte by byte, so the format does not depend on the host byte order
+	auto appendUint(std::string& out, std::uint64_t value, const int bytes) -> void {
+		for (int i = 0; i < bytes; ++i) {
+			out += static_cast<char>(value & 0xff);
+			value >>= 8;
+		}
+	}
+
+	auto appendFloat(std::string& out, const float value) -> void {
+		appendUint(out, std::bit_cast<std::uint32_t>(value), 4);
+	}
+
+	// seven bits per byte, high bit set while more bytes follow
+	auto appendVarint(std::string& out, std::uint64_t value) -> void {
+		while (value >= 0x80) {
+			out += static_cast<char>((value & 0x7f) | 0x80);
+			value >>= 7;
+		}
+		out += static_cast<char>(value);
+	}
+
+	// small negative differences stay small, 0 -1 1 -2 2 map to 0 1 2 3 4
+	auto zigzag(const std::int64_t value) -> std::uint64_t {
+		return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+	}
+
+	auto unzigzag(const std::uint64_t value) -> std::int64_t {
+		return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+	}
+
+	// bounds checked reading, every read fails once the data ran out
+	struct Reader {
+		std::string_view data;
+		std::size_t pos = 0;
+		bool ok = true;
+
+		auto uint(const int bytes) -> std::uint64_t {
+			if (data.size() - pos < static_cast<std::size_t>(bytes)) {
+				ok = false;
+				return 0;
+			}
+			std::uint64_t value = 0;
+			for (int i = bytes - 1; i >= 0; --i) {
+				value = value << 8 | static_cast<unsigned char>(data[pos + i]);
+			}
+			pos += bytes;
+			return value;
+		}
+
+		auto real() -> float {
+			return std::bit_cast<float>(static_cast<std::uint32_t>(uint(4)));
+		}
+
+		auto varint() -> std::uint64_t {
+			std::uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				const std::uint64_t byte = uint(1);
+				value |= (byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0) {
+					return value;
+				}
+			}
+			ok = false;
+			return 0;
+		}
+	};
+}
+
+SessionRecorder::SessionRecorder() {
+	events.reserve(reservedEventBytes);
+}
+
+auto SessionRecorder::begin(const SessionHeader& roundHeader, const std::int64_t roundStartNs) -> void {
+	header = roundHeader;
+	startNs = roundStartNs;
+	recording = true;
+	ticks = 0;
+	lastEventTick = 0;
+	lastTimestampNs = 0;
+	eventCount = 0;
+	events.clear();
+}
+
+auto SessionRecorder::isRecording() const -> bool {
+	return recording;
+}
+
+auto SessionRecorder::input(const InputEvent& event) -> void {
+	if (!recording) {
+		return;
+	}
+	const std::int64_t timestampNs = event.timestampNs - startNs;
+	appendVarint(events, ticks - lastEventTick);
+	events += static_cast<char>(event.type);
+	if (event.type == InputEvent::Type::Char) {
+		appendVarint(events, event.character);
+	}
+	appendVarint(events, zigzag(timestampNs - lastTimestampNs));
+	lastEventTick = ticks;
+	lastTimestampNs = timestampNs;
+	eventCount++;
+}
+
+auto SessionRecorder::tick() -> void {
+	ticks++;
+}
+
+auto SessionRecorder::finish(const std::uint64_t finalChecksum, const std::string& path) -> bool {
+	if (!recording) {
+		return false;
+	}
+	recording = false;
+
+	std::string out(magic);
+	appendUint(out, version, 4);
+	appendUint(out, header.seed, 4);
+	appendFloat(out, header.tickDuration);
+	appendFloat(out, header.worldWidth);
+	appendUint(out, static_cast<std::uint32_t>(header.fontCount), 4);
+	appendUint(out, header.limits.maxActiveWords, 8);
+	appendFloat(out, header.limits.spawnInterval);
+	appendUint(out, static_cast<std::uint32_t>(header.limits.fontQuota), 4);
+	appendFloat(out, header.limits.laneHeight);
+	appendUint(out, static_cast<std::uint32_t>(header.limits.typoTolerance), 4);
+	appendUint(out, (header.limits.keepWordsApart ? keepWordsApartFlag : 0) |
+					(header.limits.repeatWords ? repeatWordsFlag : 0) |
+					(header.limits.endless ? endlessFlag : 0), 1);
+	appendUint(out, header.dictionaryChecksum, 8);
+	appendUint(out, ticks, 8);
+	appendUint(out, finalChecksum, 8);
+	appendUint(out, eventCount, 8);
+	appendUint(out, events.size(), 8);
+	out += events;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+		std::cerr << "Cannot write recording " << path << "\n";
+		return false;
+	}
+	return true;
+}
+
+// The whole file is read at once, recordings are small
+auto SessionRecording::load(const std::string& path) -> bool {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		std::cerr << "Cannot open recording " << path << "\n";
+		return false;
+	}
+	const std::string bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+	const auto fail = [&](const char* reason) {
+		std::cerr << "Broken recording " << path << ": " << reason << "\n";
+		inputs.clear();
+		return false;
+	};
+
+	if (!std::string_view(bytes).starts_with(magic)) {
+		return fail("bad header");
+	}
+	Reader reader{bytes, magic.size()};
+	if (reader.uint(4) != version) {
+		return fail("unsupported version");
+	}
+	header.seed = static_cast<std::uint32_t>(reader.uint(4));
+	header.tickDuration = reader.real();
+	header.worldWidth = reader.real();
+	header.fontCount = static_cast<int>(reader.uint(4));
+	header.limits.maxActiveWords = reader.uint(8);
+	header.limits.spawnInterval = reader.real();
+	header.limits.fontQuota = static_cast<int>(reader.uint(4));
+	header.limits.laneHeight = reader.real();
+	header.limits.typoTolerance = static_cast<int>(reader.uint(4));
+	const auto flags = static_cast<std::uint8_t>(reader.uint(1));
+	header.limits.keepWordsApart = (flags & keepWordsApartFlag) != 0;
+	header.limits.repeatWords = (flags & repeatWordsFlag) != 0;
+	header.limits.endless = (flags & endlessFlag) != 0;
+	header.dictionaryChecksum = reader.uint(8);
+	tickCount = reader.uint(8);
+	finalChecksum = reader.uint(8);
+	const std::uint64_t eventCount = reader.uint(8);
+	const std::uint64_t eventBytes = reader.uint(8);
+	if (!reader.ok || eventBytes != bytes.size() - reader.pos || eventCount > eventBytes) {
+		return fail("truncated header");
+	}
+
+	inputs.clear();
+	inputs.reserve(eventCount);
+	std::uint64_t tick = 0;
+	std::int64_t timestampNs = 0;
+	for (std::uint64_t i = 0; i < eventCount; ++i) {
+		RecordedInput input;
+		tick += reader.varint();
+		const auto type = reader.uint(1);
+		if (type > static_cast<std::uint64_t>(InputEvent::Type::Enter)) {
+			return fail("unknown event type");
+		}
+		input.event.type = static_cast<InputEvent::Type>(type);
+		if (input.event.type == InputEvent::Type::Char) {
+			const std::uint64_t character = reader.varint();
+			if (character > 0x10ffff) {
+				return fail("bad character");
+			}
+			input.event.character = static_cast<char32_t>(character);
+		}
+		timestampNs += unzigzag(reader.varint());
+		if (!reader.ok || tick > tickCount) {
+			return fail("truncated events");
+		}
+		input.tick = tick;
+		input.event.timestampNs = timestampNs;
+		inputs.push_back(input);
+	}
+	return true;
+}
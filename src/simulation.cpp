@@ -0,0 +1,155 @@
+#include "simulation.h"
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include "profiler.h"
+
+// constructor, the thread starts idle and waits for the first round
+Simulation::Simulation(Game &game, InputQueue &input, const int tickRate, std::string recordPath)
+	: game(game), input(input), recordPath(std::move(recordPath)), timestep(tickRate) {
+	if (!this->recordPath.empty()) {
+		dictionaryChecksum = game.dictionary.checksum();
+	}
+	// every slot can hold a full screen, publishing never allocates
+	snapshots.forEach([&](FrameSnapshot &snapshot) { snapshot.reserve(game.limits.maxActiveWords); });
+	thread = std::jthread([this](const std::stop_token stop) { run(stop); });
+}
+
+Simulation::~Simulation() {
+	stop();
+}
+
+auto Simulation::startRound(const std::uint32_t seed) -> std::uint32_t {
+	requestedSeed.store(seed, std::memory_order_relaxed);
+	const std::uint32_t next = requestedRound.load(std::memory_order_relaxed) + 1;
+	requestedRound.store(next, std::memory_order_release);
+	notify();
+	return next;
+}
+
+auto Simulation::setPaused(const bool isPaused) -> void {
+	paused.store(isPaused, std::memory_order_release);
+	notify();
+}
+
+auto Simulation::latest() -> const FrameSnapshot& {
+	return snapshots.front();
+}
+
+auto Simulation::stop() -> void {
+	if (thread.joinable()) {
+		thread.request_stop();
+		notify();
+		thread.join();
+	}
+}
+
+auto Simulation::inputLatency() const -> const InputLatency& {
+	return latency;
+}
+
+auto Simulation::requestProfileExport() -> void {
+	exportProfile.store(true, std::memory_order_release);
+	notify();
+}
+
+auto Simulation::notify() -> void {
+	wakeups.fetch_add(1, std::memory_order_release);
+	wakeups.notify_one();
+}
+
+// Requests are looked at between passes, a pass is at most one tick long
+auto Simulation::run(const std::stop_token stop) -> void {
+	while (!stop.stop_requested()) {
+		MONKE_PROFILE_FRAME();
+		const std::uint32_t seen = wakeups.load(std::memory_order_acquire);
+		if (exportProfile.exchange(false, std::memory_order_acq_rel)) {
+			exportFrames();
+		}
+		if (const std::uint32_t next = requestedRound.load(std::memory_order_acquire); next != round) {
+			beginRound(next);
+		}
+		if (!running || paused.load(std::memory_order_acquire)) {
+			// nothing to simulate until the render thread asks for something,
+			// time spent waiting is not caught up later
+			wakeups.wait(seen, std::memory_order_acquire);
+			timestep.reset();
+			lastNs = nowNs();
+			continue;
+		}
+		const std::int64_t nextTickNs = advance();
+		std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(nextTickNs))));
+	}
+	// a round cut short by closing the window is kept as well
+	endRound();
+}
+
+auto Simulation::beginRound(const std::uint32_t next) -> void {
+	endRound();
+	round = next;
+	// a fresh seed per round, the recording keeps it
+	const std::uint32_t seed = requestedSeed.load(std::memory_order_relaxed);
+	game.reset(seed);
+	timestep.reset();
+	input.clear();
+	running = true;
+	lastNs = nowNs();
+	if (!recordPath.empty()) {
+		recorder.begin({seed, timestep.tickDuration(), game.worldWidth, game.fontCount(), game.limits, dictionaryChecksum}, lastNs);
+	}
+	publish(lastNs);
+}
+
+// spawning, movement, color banding, life loss and font recycling in fixed ticks,
+// every typed event is applied right before the tick it happened in
+auto Simulation::advance() -> std::int64_t {
+	MONKE_PROFILE_SCOPE("simulation");
+	const std::int64_t now = nowNs();
+	const int ticks = timestep.advance(static_cast<double>(now - lastNs) / 1e9);
+	lastNs = now;
+	const auto tickNs = static_cast<std::int64_t>(static_cast<double>(timestep.tickDuration()) * 1e9);
+	const auto sinceTickNs = static_cast<std::int64_t>(timestep.alpha() * static_cast<float>(tickNs));
+	std::int64_t tickStartNs = now - sinceTickNs - ticks * tickNs;
+	for (int i = 0; i < ticks; ++i) {
+		drainInput(input, game, tickStartNs, latency, &recorder);
+		game.tick(timestep.tickDuration());
+		recorder.tick();
+		tickStartNs += tickNs;
+	}
+	drainInput(input, game, now, latency, &recorder);
+
+	if (game.isOver()) {
+		std::cout << "Round over: score " << game.score << ", " << game.stats.wpm(now) << " WPM, "
+				  << game.stats.accuracy() * 100.0 << "% accuracy, inter-key latency p50 "
+				  << game.stats.latencyPercentileMs(0.5) << " ms, p99 " << game.stats.latencyPercentileMs(0.99) << " ms\n";
+		endRound();
+	}
+	publish(now - sinceTickNs);
+	return now - sinceTickNs + tickNs;
+}
+
+auto Simulation::publish(const std::int64_t tickNs) -> void {
+	FrameSnapshot &snapshot = snapshots.back();
+	snapshot.capture(game, tickNs, timestep.tickDuration());
+	snapshot.round = round;
+	snapshots.publish();
+}
+
+auto Simulation::endRound() -> void {
+	running = false;
+	if (recorder.isRecording() && recorder.finish(game.stateChecksum(), recordPath)) {
+		std::cout << "Round recorded to " << recordPath << ", replay with --headless --replay " << recordPath << "\n";
+	}
+}
+
+auto Simulation::exportFrames() -> void {
+#ifdef MONKE_PROFILING
+	const Profiler &profiler = Profiler::instance();
+	if (profiler.exportChromeTrace("monke_sim_trace.json") && profiler.exportCsv("monke_sim_trace.csv")) {
+		std::cout << "Exported " << profiler.frameCount() << " simulation frames to monke_sim_trace.json and monke_sim_trace.csv\n";
+	} else {
+		std::cout << "Failed to export simulation profiler frames\n";
+	}
+#endif
+}
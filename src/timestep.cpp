@@ -0,0 +1,37 @@
+#include "timestep.h"
+#include <algorithm>
+
+// constructor
+FixedTimestep::FixedTimestep(const double tickRate, const int maxTicksPerFrame)
+	: step(1.0 / tickRate), maxTicksPerFrame(std::max(1, maxTicksPerFrame)) {
+}
+
+auto FixedTimestep::advance(const double elapsed) -> int {
+	accumulator += std::max(0.0, elapsed);
+	// time beyond the catch-up cap is lost
+	accumulator = std::min(accumulator, step * maxTicksPerFrame + step);
+
+	int ticks = 0;
+	while (accumulator >= step && ticks < maxTicksPerFrame) {
+		accumulator -= step;
+		ticks++;
+	}
+	return ticks;
+}
+
+auto FixedTimestep::reset() -> void {
+	accumulator = 0.0;
+}
+
+auto FixedTimestep::setTickRate(const double tickRate) -> void {
+	step = 1.0 / tickRate;
+	accumulator = 0.0;
+}
+
+auto FixedTimestep::tickDuration() const -> float {
+	return static_cast<float>(step);
+}
+
+auto FixedTimestep::alpha() const -> float {
+	return static_cast<float>(std::clamp(accumulator / step, 0.0, 1.0));
+}
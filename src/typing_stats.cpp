@@ -0,0 +1,139 @@
+#include "typing_stats.h"
+#include <algorithm>
+
+auto TypingStats::reset() -> void {
+	*this = TypingStats();
+}
+
+auto TypingStats::recordKey(const std::int64_t timestampNs, const bool correct) -> void {
+	recordLatency(timestampNs);
+	totalKeys++;
+	if (correct) {
+		totalCorrect++;
+	}
+	push({timestampNs, 0, Kind::Key, correct});
+}
+
+auto TypingStats::recordBackspace(const std::int64_t timestampNs) -> void {
+	recordLatency(timestampNs);
+	totalBackspaces++;
+	push({timestampNs, 0, Kind::Backspace, false});
+}
+
+// A destroyed word counts its characters plus the enter that finished it
+auto TypingStats::recordEnter(const std::int64_t timestampNs, const std::size_t length, const bool hit) -> void {
+	recordLatency(timestampNs);
+	if (hit) {
+		totalHits++;
+	} else {
+		totalMisses++;
+	}
+	push({timestampNs, hit ? static_cast<std::uint32_t>(length + 1) : 0u, Kind::Enter, hit});
+}
+
+auto TypingStats::push(const Event &event) -> void {
+	if (firstTimestampNs < 0) {
+		firstTimestampNs = event.timestampNs;
+	}
+	evict(event.timestampNs);
+	// ring full, the oldest event leaves early
+	if (count == ringSize) {
+		evictOldest();
+	}
+	ring[(head + count) % ringSize] = event;
+	count++;
+
+	windowChars += event.chars;
+	if (event.kind == Kind::Key) {
+		windowKeys++;
+		windowCorrect += event.correct ? 1 : 0;
+	}
+}
+
+auto TypingStats::evict(const std::int64_t nowNs) -> void {
+	while (count > 0 && ring[head].timestampNs < nowNs - windowNs) {
+		evictOldest();
+	}
+}
+
+auto TypingStats::evictOldest() -> void {
+	const Event &event = ring[head];
+	windowChars -= event.chars;
+	if (event.kind == Kind::Key) {
+		windowKeys--;
+		windowCorrect -= event.correct ? 1 : 0;
+	}
+	head = (head + 1) % ringSize;
+	count--;
+}
+
+auto TypingStats::recordLatency(const std::int64_t timestampNs) -> void {
+	if (lastKeyNs >= 0 && timestampNs >= lastKeyNs) {
+		const std::int64_t latencyNs = timestampNs - lastKeyNs;
+		const auto bucket = std::min(static_cast<std::size_t>(latencyNs / (latencyBucketMs * 1'000'000)), latencyBuckets - 1);
+		latencyHistogram[bucket]++;
+		latencyCount++;
+		latencyTotalNs += latencyNs;
+	}
+	lastKeyNs = timestampNs;
+}
+
+// Until a full window passed, the elapsed session time is used instead
+auto TypingStats::wpm(const std::int64_t nowNs) -> double {
+	evict(nowNs);
+	if (firstTimestampNs < 0) {
+		return 0.0;
+	}
+	const std::int64_t spanNs = std::min(windowNs, nowNs - firstTimestampNs);
+	// too short to say anything
+	if (spanNs < 1'000'000'000) {
+		return 0.0;
+	}
+	const double minutes = static_cast<double>(spanNs) / 60e9;
+	return static_cast<double>(windowChars) / 5.0 / minutes;
+}
+
+auto TypingStats::accuracy() const -> double {
+	return totalKeys > 0 ? static_cast<double>(totalCorrect) / static_cast<double>(totalKeys) : 1.0;
+}
+
+auto TypingStats::recentAccuracy(const std::int64_t nowNs) -> double {
+	evict(nowNs);
+	return windowKeys > 0 ? static_cast<double>(windowCorrect) / static_cast<double>(windowKeys) : 1.0;
+}
+
+// Upper edge of the bucket holding the percentile
+auto TypingStats::latencyPercentileMs(const double p) const -> double {
+	if (latencyCount == 0) {
+		return 0.0;
+	}
+	const auto target = static_cast<std::int64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(latencyCount - 1)) + 1;
+	std::int64_t seen = 0;
+	for (std::size_t i = 0; i < latencyBuckets; ++i) {
+		seen += latencyHistogram[i];
+		if (seen >= target) {
+			return static_cast<double>((i + 1) * latencyBucketMs);
+		}
+	}
+	return static_cast<double>(latencyBuckets * latencyBucketMs);
+}
+
+auto TypingStats::meanLatencyMs() const -> double {
+	return latencyCount > 0 ? static_cast<double>(latencyTotalNs) / static_cast<double>(latencyCount) / 1e6 : 0.0;
+}
+
+auto TypingStats::keystrokes() const -> std::int64_t {
+	return totalKeys;
+}
+
+auto TypingStats::backspaces() const -> std::int64_t {
+	return totalBackspaces;
+}
+
+auto TypingStats::wordsHit() const -> std::int64_t {
+	return totalHits;
+}
+
+auto TypingStats::wordsMissed() const -> std::int64_t {
+	return totalMisses;
+}
@@ -1,23 +1,38 @@
 #include "window.h"
 #include <algorithm>
+#include <filesystem>
 #include <iostream>
+#include <memory>
 #include <ranges>
 #include <random>
-#include "../include/game.h"
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "asset_pack.h"
+#include "asset_registry.h"
+#include "audio_engine.h"
 #include "font.h"
-
-// Helper function to loop background music in a separate thread
-auto loopThreadFn(sf::Music &loop, const std::atomic<bool> &running) -> void {
-	if (running) {
-		loop.setLoop(true);
-		loop.play();
-	}
+#include "frame_scheduler.h"
+#include "hud.h"
+#include "input.h"
+#include "profiler.h"
+#include "profiler_overlay.h"
+#include "simulation.h"
+#include "startup_loader.h"
+#include "unicode.h"
+#include "word_renderer.h"
+
+namespace {
+	// characters of one font and size to rasterize before the game starts
+	struct GlyphPrewarm {
+		FontHandle handle;
+		std::u32string characters;
+		unsigned characterSize;
+	};
 }
 
 // Helper function to generate a random bright color (ensures color is not too dark)
-auto generateRandomColor() -> sf::Color {
-	std::random_device rd;
-	std::mt19937 gen(rd());
+auto generateRandomColor(RandomEngine &gen) -> sf::Color {
 	std::uniform_int_distribution<> dist(0, 255);
 	sf::Color color;
 	do {
@@ -26,35 +41,146 @@ auto generateRandomColor() -> sf::Color {
 	return color;
 }
 
+// Helper function mapping word color band to the drawn color
+auto bandColor(const ColorBand band) -> sf::Color {
+	switch (band) {
+		case ColorBand::Yellow:
+			return sf::Color::Yellow;
+		case ColorBand::Red:
+			return sf::Color::Red;
+		default:
+			return sf::Color::Green;
+	}
+}
+
 // Constructor for the Window class
-Window::Window(const int width, const int height, const std::string &title, const int frameRate) :
-	width(static_cast<int>(width)), height(static_cast<int>(height)), title(title), frameRate(frameRate), running(true),
+Window::Window(const int width, const int height, const std::string &title, const int frameRate, const int tickRate,
+			   const GameLimits &limits, std::string recordPath) :
+	width(static_cast<int>(width)), height(static_cast<int>(height)), title(title), frameRate(frameRate), tickRate(tickRate),
+	limits(limits), recordPath(std::move(recordPath)),
 	phase(GamePhase::Title) {
+	// frames are paced by the event pump in run() instead of setFramerateLimit
 	window.create(sf::VideoMode(width, height), title, sf::Style::Close);
-	window.setFramerateLimit(frameRate);
 }
 
 // Destructor for the Window class
 Window::~Window() {
-	// Stop music and join the music thread
-	running = false;
-	loop.stop();
-	if (loopThread.joinable()) {
-		loopThread.join();
-	}
+	audio.stopMusic();
 }
 
 // Main game loop and logic
 auto Window::run() -> void {
-	// Initialize the game
-	Game game("../assets/words.txt");
-
-	// Load fonts used in the game
-	auto loadedFonts = Game::loadAllFonts();
-
-	// Fonts used for various texts
-	Font antonsc = loadedFonts[1];
-	Font orangeKid = loadedFonts[2];
+#ifdef MONKE_PROFILING
+	// time to first frame and to fully loaded are reported on stdout by profiling builds
+	sf::Clock startupClock;
+#endif
+
+	// one pack next to the executable, or the assets directory of the source tree
+	const std::filesystem::path executableDir = executableDirectory();
+	AssetRegistry assets((executableDir / ".." / "assets").string(), (executableDir / "monke.pak").string());
+	assets.discoverFonts();
+
+	// Only the fonts of the title screen are parsed before the first frame,
+	// the rest is parsed in the background
+	const FontHandle antonscHandle = assets.fontHandle("AntonSC");
+	const FontHandle orangeKidHandle = assets.fontHandle("OrangeKid");
+	Font &antonsc = assets.font(antonscHandle);
+	Font &orangeKid = assets.font(orangeKidHandle);
+	assets.loadFontsAsync();
+
+	// Dictionary, icon and audio are decoded by workers, results come back through futures.
+	// The audio engine belongs to the worker until its future is ready.
+	StartupLoader loader;
+	const auto gameLoaded = loader.add([&assets, limits = limits, fontCount = assets.fontCount(),
+										worldWidth = static_cast<float>(window.getSize().x)] {
+		Dictionary words;
+		words.loadFromMemory(assets.bytes("words.txt"));
+		return std::make_unique<Game>(std::move(words), fontCount, worldWidth, limits);
+	});
+	const auto iconLoaded = loader.add([&assets] {
+		sf::Image icon;
+		const std::string_view iconData = assets.bytes("img/jp2.png");
+		if (!icon.loadFromMemory(iconData.data(), iconData.size())) {
+			std::cout << "Failed to load icon img/jp2.png\n";
+		}
+		return icon;
+	});
+	// Background music is decoded whole and looped from memory, the click
+	// is decoded once and played on the voice pool
+	const auto audioLoaded = loader.add([this, &assets] {
+		audio.loadMusic("audio/loop.ogg", assets.bytes("audio/loop.ogg"), true);
+		return audio.loadEffect("audio/click.ogg", assets.bytes("audio/click.ogg"));
+	});
+
+	// Typed characters travel to the simulation thread with the time they were pulled
+	InputQueue inputQueue;
+
+	// filled in as the futures complete, once the game is there it belongs to the simulation thread
+	Game *game = nullptr;
+	std::unique_ptr<Simulation> simulation;
+	bool iconSet = false;
+	bool audioReady = false;
+	SoundHandle clickSound = -1;
+
+	// Glyphs are rasterized before the game can start, so new letters and fonts do not
+	// stall gameplay. Atlas uploads need the OpenGL context of this thread, so it is
+	// done here one step per frame once the fonts and the word charset are known.
+	std::vector<GlyphPrewarm> prewarmSteps;
+	std::u32string printableChars;
+	for (char32_t c = U' '; c < U'\x7f'; ++c) {
+		printableChars += c;
+	}
+	for (const unsigned size : {15u, 20u, 30u, 40u}) {
+		prewarmSteps.push_back({orangeKidHandle, printableChars, size});
+	}
+	prewarmSteps.push_back({antonscHandle, printableChars, 90});
+	const std::size_t titleSteps = prewarmSteps.size();
+	const std::size_t prewarmTotal = titleSteps + static_cast<std::size_t>(assets.fontCount());
+	std::size_t prewarmed = 0;
+
+	// Collect finished startup work, never blocks, returns true once everything is loaded
+	auto pollLoading = [&]() -> bool {
+		if (game == nullptr && isReady(gameLoaded)) {
+			game = gameLoaded.get().get();
+			simulation = std::make_unique<Simulation>(*game, inputQueue, tickRate, recordPath);
+			simulation->setPaused(isPaused);
+			// the dictionary never changes, reading it here is safe
+			const std::u32string& wordChars = game->dictionary.charset();
+			for (FontHandle handle = 0; handle < assets.fontCount(); ++handle) {
+				prewarmSteps.push_back({handle, wordChars, 20});
+			}
+		}
+		if (!iconSet && isReady(iconLoaded)) {
+			if (const sf::Image &icon = iconLoaded.get(); icon.getSize().x > 0) {
+				window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
+			}
+			iconSet = true;
+		}
+		if (!audioReady && isReady(audioLoaded)) {
+			clickSound = audioLoaded.get();
+			audioReady = true;
+		}
+		// title fonts are already parsed, the rest only once every worker is done with them
+		const bool fontsLoaded = assets.loadedFontCount() == assets.fontCount();
+		if (prewarmed < prewarmSteps.size() && (prewarmed < titleSteps || fontsLoaded)) {
+			const GlyphPrewarm &step = prewarmSteps[prewarmed++];
+			assets.prewarmGlyphs(step.handle, step.characters, step.characterSize);
+		}
+		return loader.done() && prewarmed == prewarmTotal;
+	};
+	// share of the startup work that is done, for the title screen
+	auto loadingProgress = [&]() -> float {
+		const auto done = static_cast<float>(loader.completed() + assets.loadedFontCount()) + static_cast<float>(prewarmed);
+		const auto total = static_cast<float>(loader.total() + assets.fontCount()) + static_cast<float>(prewarmTotal);
+		return done / total;
+	};
+	bool loaded = false;
+#ifdef MONKE_PROFILING
+	bool firstFrameShown = false;
+#endif
+
+	// Active words are drawn in one batch per font
+	WordRenderer wordRenderer(assets, 20);
 
 	// Title screen texts
 	sf::Text monkey("Monke Typer", antonsc.getSfFont(), 90);
@@ -67,38 +193,40 @@ auto Window::run() -> void {
 	pressToStart.setPosition(435.f, 360.f);
 	bool isVisible = true; // Controls blinking visibility of text
 	sf::Clock blinkClock; // Timer for blinking effect
-	float xvel = 4.f; // Speed for horizontal movement of title text
+	float xvel = 240.f; // Speed for horizontal movement of title text, pixels per second
+	// the title moves in steps, the screen is still in between
+	const sf::Time titleStep = sf::seconds(1.f / 30.f);
+	sf::Clock titleStepClock;
+	const sf::Time blinkPeriod = sf::milliseconds(350);
+	RandomEngine colorGen(randomSeed()); // title colors, not part of any round
+
+	// Loading progress, shown in place of pressToStart
+	sf::Text loadingText("LOADING", orangeKid.getSfFont(), 30);
+	loadingText.setFillColor(sf::Color::White);
+	loadingText.setPosition(435.f, 360.f);
+	const sf::Vector2f loadingBarSize(400.f, 4.f);
+	sf::RectangleShape loadingBarBack(loadingBarSize);
+	loadingBarBack.setFillColor(sf::Color(60, 60, 60));
+	loadingBarBack.setPosition(435.f, 405.f);
+	sf::RectangleShape loadingBar({0.f, loadingBarSize.y});
+	loadingBar.setFillColor(sf::Color::White);
+	loadingBar.setPosition(loadingBarBack.getPosition());
+	std::string loadingLabel; // reused for formatting
 
 	// Game Over screen text
 	sf::Text gameOverText("GAME OVER", antonsc.getSfFont(), 90);
 	gameOverText.setFillColor(sf::Color::White);
 	gameOverText.setPosition(430.f, 250.f);
 
-	// Player input text
-	sf::Text userInputText;
-	userInputText.setFont(orangeKid.getSfFont());
-	userInputText.setCharacterSize(30);
-	userInputText.setFillColor(sf::Color::White);
-
-	// Score display text
-	sf::Text scoreText;
-	scoreText.setFont(orangeKid.getSfFont());
-	scoreText.setCharacterSize(20);
-	scoreText.setFillColor(sf::Color::White);
-	scoreText.setPosition(20.f, 20.f);
-
-	// Lives display text
-	sf::Text livesText;
-	livesText.setFont(orangeKid.getSfFont());
-	livesText.setCharacterSize(20);
-	livesText.setFillColor(sf::Color::White);
-	livesText.setPosition(20.f, 50.f);
-
 	// Pause text
 	sf::Text pauseText;
 	pauseText.setFont(orangeKid.getSfFont());
 	pauseText.setCharacterSize(40);
 	pauseText.setString("PAUSED");
+	pauseText.setPosition(((static_cast<float>(width) - pauseText.getLocalBounds().width) / 2.f) - 20.f, 200);
+
+	// Shortcut instructions, score, lives and player input
+	Hud hud(orangeKid.getSfFont(), window.getSize());
 
 	// Instruction to return to the title screen
 	sf::Text altToTitle;
@@ -108,144 +236,162 @@ auto Window::run() -> void {
 	altToTitle.setFillColor(sf::Color::White);
 	altToTitle.setPosition(480.f, 360.f);
 
-	// Shortcut instructions
-	sf::Text volUpText( "Volume up      (+)", orangeKid.getSfFont(), 15);
-	sf::Text volDownText("Volume down  (-)", orangeKid.getSfFont(), 15);
-	sf::Text volMuteText("Mute               (/)", orangeKid.getSfFont(), 15);
-	sf::Text vol100Text("Volume Max   (*)", orangeKid.getSfFont(), 15);
-	sf::Text pauseInfo( "Pause        (CTRL)", orangeKid.getSfFont(), 15);
-	sf::Text exitInfo(  "Exit             (ESC)", orangeKid.getSfFont(), 15);
-	float windowHeight = static_cast<float>(window.getSize().y);
-	sf::Vector2f volControl(1280.f - volUpText.getLocalBounds().width - 10.f, windowHeight - 10.f - volUpText.getLocalBounds().height);
-	volUpText.setPosition(volControl);
-	volDownText.setPosition(volControl.x, volControl.y - volDownText.getLocalBounds().height - 5.f);
-	volMuteText.setPosition(volControl.x, volDownText.getPosition().y - volMuteText.getLocalBounds().height - 5.f);
-	vol100Text.setPosition(volControl.x, volMuteText.getPosition().y - vol100Text.getLocalBounds().height - 5.f);
-	pauseInfo.setPosition(volControl.x, vol100Text.getPosition().y - pauseInfo.getLocalBounds().height - 5.f);
-	exitInfo.setPosition(volControl.x, pauseInfo.getPosition().y - exitInfo.getLocalBounds().height - 5.f);
-
-	// Set colors for shortcut instructions
-	volUpText.setFillColor(sf::Color::White);
-	volDownText.setFillColor(sf::Color::White);
-	volMuteText.setFillColor(sf::Color::White);
-	vol100Text.setFillColor(sf::Color::White);
-	pauseInfo.setFillColor(sf::Color::White);
-	exitInfo.setFillColor(sf::Color::White);
-
-	// Load and set the window icon
-	if (sf::Image icon; !icon.loadFromFile("../assets/img/jp2.png")) {
-		std::cout << "Failed to load icon ../assets/img/jp2.png\n";
-	} else {
-		window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
-	}
-
-	// Background music setup in a separate thread
-	if (!loop.openFromFile("../assets/audio/loop.ogg")) {
-		std::cout << "Failed to open loop music ../assets/audio/loop.ogg\n";
-	}
-	loopThread = std::thread(loopThreadFn, std::ref(loop), std::ref(running));
-
-	// Click sound effect setup
-	sf::SoundBuffer clickSoundBuffer;
-	if (!clickSoundBuffer.loadFromFile("../assets/audio/click.ogg")) {
-		std::cout << "Failed to load click sound ../assets/audio/click.ogg\n";
-	}
-	sf::Sound clickSound;
-	clickSound.setBuffer(clickSoundBuffer);
-
-	// Timers for delta time and word spawning
-	sf::Clock clock; // Timer for delta time
-	sf::Clock spawnClock; // Timer for word spawning intervals
+	// round the Playing phase shows, older snapshots are not drawn
+	std::uint32_t currentRound = 0;
+	// interpolation between the last two ticks, kept while paused
+	float alpha = 1.f;
 
 	// Flag to skip the next character input if a numpad key is used (for volume controls)
 	bool skipNumpadNextChar = false;
 
+#ifdef MONKE_PROFILING
+	// Frame time overlay, F3 toggles and F4 exports
+	ProfilerOverlay profilerOverlay(orangeKid.getSfFont(),
+		{"events", "words", "hud", "display"});
+#endif
+
+	// Still screens are drawn only on input and blink or animation deadlines
+	FrameScheduler scheduler(frameRate);
+	std::int64_t frameStartNs = 0;
+	// draw again once period passed on timer
+	auto wakeAfter = [&](const sf::Clock &timer, const sf::Time period) {
+		scheduler.wakeAt(frameStartNs + (period - timer.getElapsedTime()).asMicroseconds() * 1000);
+	};
+	// clicks and key presses seen since the last frame, a frame may be drawn long after them
+	bool startClicked = false;
+	bool altPressed = false;
+
 	// main game loop
 	while (window.isOpen()) {
-		float dt = clock.restart().asSeconds();
+		MONKE_PROFILE_FRAME();
 		sf::Event event{};
 
-		while (window.pollEvent(event)) {
-			if (event.type == sf::Event::Closed) {
-				window.close();
-				running = false;
-				loop.stop();
-			}
-			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
-				window.close();
-				running = false;
-				loop.stop();
-			}
-
-			// pause and resume game
-			if (event.type == sf::Event::KeyPressed &&
-				(event.key.code == sf::Keyboard::LControl ||
-				event.key.code == sf::Keyboard::RControl)) {
-				isPaused = !isPaused;
-	}
+		// events are pulled every millisecond until the next frame is due, so a key
+		// press is timestamped when it arrives instead of at the frame boundary,
+		// on still screens less often until input or a deadline asks for a frame
+		do {
+			{
+				MONKE_PROFILE_SCOPE("events");
+				while (window.pollEvent(event)) {
+					// nothing reacts to the mouse moving
+					if (event.type != sf::Event::MouseMoved) {
+						scheduler.invalidate();
+					}
+					if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+						startClicked = true;
+					}
+					if (event.type == sf::Event::KeyPressed &&
+						(event.key.code == sf::Keyboard::LAlt || event.key.code == sf::Keyboard::RAlt)) {
+						altPressed = true;
+					}
+					if (event.type == sf::Event::Closed) {
+						window.close();
+					}
+					if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+						window.close();
+					}
 
-			// shortcuts handling
-			if (event.type == sf::Event::KeyPressed) {
-				clickSound.play(); // your SFX
+#ifdef MONKE_PROFILING
+					// profiler overlay and export
+					if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+						profilerOverlay.toggle();
+					}
+					if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+						profilerOverlay.exportFrames();
+						if (simulation) {
+							simulation->requestProfileExport();
+						}
+					}
+#endif
+
+					// pause and resume game
+					if (event.type == sf::Event::KeyPressed &&
+						(event.key.code == sf::Keyboard::LControl ||
+						event.key.code == sf::Keyboard::RControl)) {
+						isPaused = !isPaused;
+						if (simulation) {
+							simulation->setPaused(isPaused);
+						}
+					}
 
-				// volume max
-				if (event.key.code == sf::Keyboard::Multiply) {
-					loop.setVolume(100.f);
-					skipNumpadNextChar = true;
-				}
-				// volume up
-				else if (event.key.code == sf::Keyboard::Add) {
-					loop.setVolume(std::min(loop.getVolume() + 10.f, 100.f));
-					skipNumpadNextChar = true;
-				}
-				// volume down
-				else if (event.key.code == sf::Keyboard::Subtract) {
-					float newVol = loop.getVolume() - 10.f;
-					if (newVol < 0.f)
-						newVol = 0.f;
-					loop.setVolume(newVol);
-					skipNumpadNextChar = true;
-				}
-				// muting
-				else if (event.key.code == sf::Keyboard::Divide) {
-					loop.setVolume(0.f);
-					skipNumpadNextChar = true;
-				} else {
-					skipNumpadNextChar = false;
-				}
-			}
+					// shortcuts handling, audio is touched only once its loader is done
+					if (event.type == sf::Event::KeyPressed && audioReady) {
+						audio.play(clickSound);
 
-			// text event handling
-			if (phase == GamePhase::Playing && !isPaused) {
-				if (event.type == sf::Event::TextEntered) {
-					// when num pad key is pressed, skip the next character
-					if (skipNumpadNextChar) {
-						skipNumpadNextChar = false;
-						continue;
+						// volume max
+						if (event.key.code == sf::Keyboard::Multiply) {
+							audio.setMusicVolume(100.f);
+							skipNumpadNextChar = true;
+						}
+						// volume up
+						else if (event.key.code == sf::Keyboard::Add) {
+							audio.setMusicVolume(std::min(audio.musicVolume() + 10.f, 100.f));
+							skipNumpadNextChar = true;
+						}
+						// volume down
+						else if (event.key.code == sf::Keyboard::Subtract) {
+							float newVol = audio.musicVolume() - 10.f;
+							if (newVol < 0.f)
+								newVol = 0.f;
+							audio.setMusicVolume(newVol);
+							skipNumpadNextChar = true;
+						}
+						// muting
+						else if (event.key.code == sf::Keyboard::Divide) {
+							audio.setMusicVolume(0.f);
+							skipNumpadNextChar = true;
+						} else {
+							skipNumpadNextChar = false;
+						}
 					}
 
-					// handling player entered text
-					if (event.text.unicode == 8) {
-						// backspace
-						if (!playerInput.empty())
-							playerInput.pop_back();
-					} else if (event.text.unicode == 13) {
-						// enter
-						Game::checkWordOnScreen(playerInput, game.activeWords, game);
-						for (auto &gw: game.activeWords) {
-							if (!gw.isAlive)
-								score++;
-						}
-						playerInput.clear();
-						// adding player input to the string that will be drawn on to the screen
-					} else if (event.text.unicode < 128) {
-						if (char typed = static_cast<char>(event.text.unicode); std::isprint(typed)) {
-							playerInput += typed;
+					// text event handling
+					if (phase == GamePhase::Playing && !isPaused) {
+						if (event.type == sf::Event::TextEntered) {
+							// when num pad key is pressed, skip the next character
+							if (skipNumpadNextChar) {
+								skipNumpadNextChar = false;
+								continue;
+							}
+
+							// handling player entered text
+							InputEvent input;
+							input.timestampNs = nowNs();
+							if (event.text.unicode == 8) {
+								// backspace
+								input.type = InputEvent::Type::Backspace;
+							} else if (event.text.unicode == 13) {
+								// enter
+								input.type = InputEvent::Type::Enter;
+							} else if (const auto typed = static_cast<char32_t>(event.text.unicode); isPrintable(typed)) {
+								// adding player input to the string that will be drawn on to the screen
+								input.character = typed;
+							} else {
+								continue;
+							}
+							if (!inputQueue.push(input)) {
+								std::cout << "Input queue full, key dropped\n";
+							}
 						}
 					}
 				}
 			}
+			if (scheduler.due(nowNs())) {
+				break;
+			}
+			sf::sleep(sf::microseconds(scheduler.sleepNs(nowNs()) / 1000));
+		} while (window.isOpen());
+		frameStartNs = nowNs();
+		scheduler.beginFrame(frameStartNs);
+
+		// startup work that finished since the last frame
+		if (!loaded && pollLoading()) {
+			loaded = true;
+#ifdef MONKE_PROFILING
+			std::cout << "Loaded in " << startupClock.getElapsedTime().asMilliseconds() << " ms\n";
+#endif
 		}
+
 		// window clearing
 		window.clear();
 
@@ -254,174 +400,153 @@ auto Window::run() -> void {
 		// ----------------- tittle phase -----------------
 		if (phase == GamePhase::Title) {
 
-			if (loop.getStatus() != sf::Music::Playing) {
-				loop.play();
+			if (audioReady) {
+				audio.playMusic();
 			}
 			// animated title text
 			window.draw(monkey);
-			if (monkeyTextPosition.x < 360.f || monkeyTextPosition.x > 440.f) {
-				xvel = -xvel;
-				monkey.setFillColor(generateRandomColor());
-
+			if (titleStepClock.getElapsedTime() >= titleStep) {
+				titleStepClock.restart();
+				monkeyTextPosition.x += xvel * titleStep.asSeconds();
+				if ((monkeyTextPosition.x < 360.f && xvel < 0.f) || (monkeyTextPosition.x > 440.f && xvel > 0.f)) {
+					xvel = -xvel;
+					monkey.setFillColor(generateRandomColor(colorGen));
+				}
+				monkey.setPosition(monkeyTextPosition);
 			}
-			monkeyTextPosition.x += xvel;
-			monkey.setPosition(monkeyTextPosition);
+			wakeAfter(titleStepClock, titleStep);
 
 			// blinking PressToStart
-			if (blinkClock.getElapsedTime().asMilliseconds() >= 350) {
+			if (blinkClock.getElapsedTime() >= blinkPeriod) {
 				isVisible = !isVisible;
 				blinkClock.restart();
 			}
-			if (isVisible) {
+			if (!loaded) {
+				// progress instead of the start prompt until everything is loaded
+				const float progress = loadingProgress();
+				loadingLabel = "LOADING " + std::to_string(static_cast<int>(progress * 100.f)) + "%";
+				loadingText.setString(loadingLabel);
+				loadingBar.setSize({loadingBarSize.x * progress, loadingBarSize.y});
+				window.draw(loadingText);
+				window.draw(loadingBarBack);
+				window.draw(loadingBar);
+				scheduler.animate();
+			} else if (isVisible) {
 				window.draw(pressToStart);
 			}
+			wakeAfter(blinkClock, blinkPeriod);
 
 			// drawing shortcut instructions
-			window.draw(volUpText);
-			window.draw(volDownText);
-			window.draw(volMuteText);
-			window.draw(vol100Text);
-			window.draw(pauseInfo);
-			window.draw(exitInfo);
-
-			// start of the game when left mouse button is pressed
-			if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-				phase = GamePhase::Playing;
-
-				// game parameters reset
-				score = 0;
-				lives = 6;
-				playerInput.clear();
+			hud.drawShortcuts(window);
 
-				// reset of active words and init of inactive words
-				game.activeWords.clear();
-				game.initInactiveWords();
+			// start of the game when left mouse button is pressed, not before everything is loaded
+			if (loaded && startClicked) {
+				phase = GamePhase::Playing;
 
-				spawnClock.restart();
+				// the simulation thread resets the game with a fresh seed
+				currentRound = simulation->startRound(randomSeed());
 			}
 		}
 
 		// ----------------- game phase -----------------
 		else if (phase == GamePhase::Playing) {
-
+			// ticks run on the simulation thread, the frame shows its newest snapshot
+			const FrameSnapshot &snapshot = simulation->latest();
 			if (!isPaused) {
-				// spawn for every 1.5s
-				if (spawnClock.getElapsedTime().asSeconds() >= 1.5f) {
-					game.spawnWord();
-					spawnClock.restart();
-				}
-
-				// logika aktualizacji stanu gry
-				for (auto &gw: game.activeWords) {
-					gw.update(dt);
-
-					float x = gw.sfText.getPosition().x;
-					float ww = static_cast<float>(window.getSize().x); // factual window width
-
-					// color change based on position
-					if (x < ww * 0.5f) {
-						gw.sfText.setFillColor(sf::Color::Green);
-					} else if (x < ww * 0.75f) {
-						gw.sfText.setFillColor(sf::Color::Yellow);
-					} else {
-						gw.sfText.setFillColor(sf::Color::Red);
-					}
+				scheduler.animate();
+				alpha = snapshot.alpha(frameStartNs);
+			}
 
-					// word goes out of screen = lose life
-					if (x > ww) {
-						gw.isAlive = false;
-						lives--;
-					}
+			// until the simulation started the round, the last snapshot shows the previous one
+			if (snapshot.round == currentRound) {
+				// check if game is over
+				if (snapshot.over) {
+					phase = GamePhase::GameOver;
 				}
-				// font recycling
-				std::erase_if(game.activeWords, [&](Game::GameWord &w) -> bool {
-					if (!w.isAlive) {
-						game.releaseFont(w.fontIndex);
-						w.fontIndex = -1;
-						w.isAlive = false;
-						game.inActiveWords.push_back(w);
-						return true;
-					}
-					return false;
-				});
-			} // end of if(!isPaused)
 
-			// check if game is over
-			if (lives <= 0) {
-				phase = GamePhase::GameOver;
-			}
+				// drawing activeWords
+				{
+					MONKE_PROFILE_SCOPE("words");
+					wordRenderer.build(snapshot, alpha);
+					wordRenderer.draw(window);
+				}
 
-			// drawing activeWords
-			for (auto &gw: game.activeWords) {
-				window.draw(gw.sfText);
+				// drawing shortcut instructions
+				hud.drawShortcuts(window);
+
+				// drawing playerInput, lives, score and typing statistics
+				MONKE_PROFILE_SCOPE("hud");
+				hud.setInput(snapshot.input);
+				hud.setScore(snapshot.score);
+				hud.setLives(snapshot.lives);
+				hud.setWpm(snapshot.wpm);
+				hud.setAccuracy(snapshot.accuracy);
+				hud.drawPlaying(window);
+			} else {
+				hud.drawShortcuts(window);
 			}
-			// drawing shortcut instructions
-			window.draw(volUpText);
-			window.draw(volDownText);
-			window.draw(volMuteText);
-			window.draw(vol100Text);
-			window.draw(pauseInfo);
-			window.draw(exitInfo);
-
-			// drawing playerInput
-			userInputText.setString(playerInput);
-			float textWidth = userInputText.getLocalBounds().width;
-			float xPos = (static_cast<float>(window.getSize().x) - textWidth) / 2.f;
-			float yPos = static_cast<float>(window.getSize().y) - 50.f;
-			userInputText.setPosition(xPos, yPos);
-			window.draw(userInputText);
-
-			// lives and score
-			scoreText.setString("Score: " + std::to_string(score));
-			livesText.setString("Lives: " + std::to_string(lives));
-			window.draw(scoreText);
-			window.draw(livesText);
 
 			// what to do when paused
 			if (isPaused) {
-				float pw = pauseText.getLocalBounds().width;
-				pauseText.setPosition(((static_cast<float>(width) - pw) / 2.f)-20.f, 200);
 				window.draw(pauseText);
-
 			}
 		}
 		// ----------------- game over phase -----------------
 		else if (phase == GamePhase::GameOver) {
 			// draw game over text
-			loop.stop();
+			audio.stopMusic();
 			window.draw(gameOverText);
 
 			// drrawing shortcut instructions
-			window.draw(volUpText);
-			window.draw(volDownText);
-			window.draw(volMuteText);
-			window.draw(vol100Text);
-			window.draw(pauseInfo);
-			window.draw(exitInfo);
+			hud.drawShortcuts(window);
 
 			// blinking effect
-			if (blinkClock.getElapsedTime().asMilliseconds() >= 350) {
+			if (blinkClock.getElapsedTime() >= blinkPeriod) {
 				isVisible = !isVisible;
 				blinkClock.restart();
 			}
 			if (isVisible) {
 				window.draw(altToTitle);
 			}
+			wakeAfter(blinkClock, blinkPeriod);
 
 			// alt to title
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt) || sf::Keyboard::isKeyPressed(sf::Keyboard::RAlt)) {
+			if (altPressed) {
 				phase = GamePhase::Title;
 			}
 		}
 
 		// ========== end of phase handling ==========
 
+#ifdef MONKE_PROFILING
+		// the overlay shows frame times, it needs frames
+		if (profilerOverlay.isVisible()) {
+			scheduler.animate();
+		}
+		profilerOverlay.draw(window);
+#endif
+		startClicked = false;
+		altPressed = false;
+
 		// window display
-		window.display();
+		{
+			MONKE_PROFILE_SCOPE("display");
+			window.display();
+		}
+#ifdef MONKE_PROFILING
+		if (!firstFrameShown) {
+			firstFrameShown = true;
+			std::cout << "First frame after " << startupClock.getElapsedTime().asMilliseconds() << " ms\n";
+		}
+#endif
 	}
 
-	// stop music and join the music thread if destructor fails to do so
-	if (loopThread.joinable()) {
-		loopThread.join();
+	// the simulation records a round cut short by closing the window as well
+	if (!simulation) {
+		return;
+	}
+	simulation->stop();
+	if (const InputLatency &inputLatency = simulation->inputLatency(); inputLatency.count > 0) {
+		std::cout << "Input latency: mean " << inputLatency.meanMs() << " ms, max " << inputLatency.maxMs() << " ms\n";
 	}
 }
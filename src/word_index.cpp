@@ -0,0 +1,189 @@
+#include "word_index.h"
+#include <algorithm>
+
+namespace {
+	const std::vector<WordHandle> noMatches;
+}
+
+// constructor, creates the root node
+WordIndex::WordIndex() {
+	// typed input longer than this allocates once
+	input.reserve(64);
+	path.reserve(65);
+	clear();
+}
+
+auto WordIndex::findChild(const int node, const char32_t c) const -> int {
+	for (int child = nodes[node].firstChild; child != -1; child = nodes[child].nextSibling) {
+		if (nodes[child].key == c) {
+			return child;
+		}
+	}
+	return -1;
+}
+
+auto WordIndex::allocateNode(const int parent, const char32_t c) -> int {
+	int node;
+	if (freeNodes.empty()) {
+		node = static_cast<int>(nodes.size());
+		nodes.emplace_back(c, parent, nodes[parent].depth + 1);
+		// a terminal node holds one word unless the dictionary repeats it
+		nodes.back().words.reserve(2);
+	} else {
+		node = freeNodes.back();
+		freeNodes.pop_back();
+		nodes[node].key = c;
+		nodes[node].parent = parent;
+		nodes[node].depth = nodes[parent].depth + 1;
+	}
+	nodes[node].nextSibling = nodes[parent].firstChild;
+	nodes[parent].firstChild = node;
+	return node;
+}
+
+// Word list keeps its capacity for the next user of the node
+auto WordIndex::freeNode(const int node) -> void {
+	int *link = &nodes[nodes[node].parent].firstChild;
+	while (*link != node) {
+		link = &nodes[*link].nextSibling;
+	}
+	*link = nodes[node].nextSibling;
+
+	// typed input can not follow a removed node
+	if (const auto depth = static_cast<std::size_t>(nodes[node].depth); path.size() > depth && path[depth] == node) {
+		path.resize(depth);
+	}
+	nodes[node].firstChild = -1;
+	nodes[node].nextSibling = -1;
+	nodes[node].words.clear();
+	freeNodes.push_back(node);
+}
+
+// Add word and bump counters along its path
+auto WordIndex::insert(const std::u32string_view word, const WordHandle handle) -> int {
+	int node = 0;
+	nodes[node].prefixCount++;
+	for (const char32_t c : word) {
+		int child = findChild(node, c);
+		if (child == -1) {
+			child = allocateNode(node, c);
+		}
+		node = child;
+		nodes[node].prefixCount++;
+	}
+	nodes[node].words.push_back(handle);
+
+	// new word can continue the typed input
+	extendPath();
+	return node;
+}
+
+// Remove word and drop counters along its path, nodes left without words are freed
+auto WordIndex::erase(const int node, const WordHandle handle) -> void {
+	if (node < 0) {
+		return;
+	}
+	auto &words = nodes[node].words;
+	if (const auto it = std::ranges::find(words, handle); it != words.end()) {
+		*it = words.back();
+		words.pop_back();
+	}
+	for (int n = node; n != -1;) {
+		const int parent = nodes[n].parent;
+		if (--nodes[n].prefixCount == 0 && parent != -1) {
+			freeNode(n);
+		}
+		n = parent;
+	}
+}
+
+auto WordIndex::clear() -> void {
+	// nodes stay allocated, all but the root become free
+	if (nodes.empty()) {
+		nodes.emplace_back(U'\0', -1, 0);
+	}
+	freeNodes.clear();
+	for (int node = static_cast<int>(nodes.size()) - 1; node >= 0; --node) {
+		nodes[node].firstChild = -1;
+		nodes[node].nextSibling = -1;
+		nodes[node].words.clear();
+		nodes[node].prefixCount = 0;
+		if (node > 0) {
+			freeNodes.push_back(node);
+		}
+	}
+	input.clear();
+	path.assign(1, 0);
+}
+
+// Nodes are created right away and wait on the free list
+auto WordIndex::reserve(const std::size_t nodeCount) -> void {
+	nodes.reserve(nodeCount);
+	freeNodes.reserve(nodeCount);
+	while (nodes.size() < nodeCount) {
+		freeNodes.push_back(static_cast<int>(nodes.size()));
+		nodes.emplace_back(U'\0', -1, 0);
+		nodes.back().words.reserve(2);
+	}
+}
+
+// Move the cursor one character down
+auto WordIndex::push(const char32_t c) -> void {
+	input += c;
+	extendPath();
+}
+
+// Move the cursor one character up
+auto WordIndex::pop() -> void {
+	if (input.empty()) {
+		return;
+	}
+	input.pop_back();
+	if (path.size() > input.size() + 1) {
+		path.pop_back();
+	}
+}
+
+auto WordIndex::clearInput() -> void {
+	input.clear();
+	path.assign(1, 0);
+}
+
+auto WordIndex::typed() const -> const std::u32string& {
+	return input;
+}
+
+auto WordIndex::extendPath() -> void {
+	while (path.size() <= input.size()) {
+		const int child = findChild(path.back(), input[path.size() - 1]);
+		if (child == -1) {
+			return;
+		}
+		path.push_back(child);
+	}
+}
+
+auto WordIndex::fullyMatched() const -> bool {
+	return path.size() == input.size() + 1;
+}
+
+auto WordIndex::candidateCount() const -> int {
+	return fullyMatched() ? nodes[path.back()].prefixCount : 0;
+}
+
+auto WordIndex::exactMatches() const -> const std::vector<WordHandle>& {
+	return fullyMatched() ? nodes[path.back()].words : noMatches;
+}
+
+// Word is highlighted when the cursor node is one of its ancestors
+auto WordIndex::matchedLength(const int node) const -> std::size_t {
+	if (node < 0 || input.empty() || !fullyMatched()) {
+		return 0;
+	}
+	const int cursor = path.back();
+	int n = node;
+	while (nodes[n].depth > nodes[cursor].depth) {
+		n = nodes[n].parent;
+	}
+	return n == cursor ? input.size() : 0;
+}
@@ -0,0 +1,120 @@
+#include "word_pool.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+auto WordPool::reset(const std::size_t count) -> void {
+	ids.resize(count);
+	std::iota(ids.begin(), ids.end(), 0u);
+	positions.resize(count);
+	std::iota(positions.begin(), positions.end(), 0u);
+	rebuildTree();
+}
+
+// Weights are scaled so the largest one keeps 24 bits of precision like a float,
+// sums of up to billions of ids still fit the 64 bit tree
+auto WordPool::setWeights(const std::vector<float>& newWeights) -> void {
+	const float maxWeight = newWeights.empty() ? 0.f : *std::ranges::max_element(newWeights);
+	weights.clear();
+	// nothing to weight by, fall back to uniform picking
+	if (maxWeight > 0.f) {
+		weights.resize(newWeights.size());
+		for (std::size_t id = 0; id < weights.size(); ++id) {
+			if (newWeights[id] > 0.f) {
+				const double scaled = std::round(static_cast<double>(newWeights[id]) / maxWeight * weightScale);
+				weights[id] = std::max(static_cast<std::uint32_t>(scaled), 1u);
+			}
+		}
+	}
+	rebuildTree();
+}
+
+auto WordPool::take(RandomEngine& gen) -> std::uint32_t {
+	return removeAt(pick(gen));
+}
+
+auto WordPool::sample(RandomEngine& gen) const -> std::uint32_t {
+	return ids[pick(gen)];
+}
+
+// Pick a random position, weighted picks find the id whose weight range holds
+// a random point of the total by walking the tree from its largest step down
+auto WordPool::pick(RandomEngine& gen) const -> std::size_t {
+	// only zero weights left, every id is as likely
+	if (weights.empty() || totalWeight == 0) {
+		return uniformBelow(gen, static_cast<std::uint32_t>(ids.size()));
+	}
+	std::uint64_t target = uniformBelow64(gen, totalWeight);
+	std::size_t id = 0;
+	for (std::size_t step = std::bit_floor(tree.size() - 1); step > 0; step >>= 1) {
+		if (id + step < tree.size() && tree[id + step] <= target) {
+			id += step;
+			target -= tree[id];
+		}
+	}
+	return positions[id];
+}
+
+auto WordPool::give(const std::uint32_t id) -> void {
+	if (contains(id)) {
+		return;
+	}
+	positions[id] = static_cast<std::uint32_t>(ids.size());
+	ids.push_back(id);
+	if (!weights.empty()) {
+		addWeight(id, weights[id]);
+	}
+}
+
+// Swap with the last id and pop
+auto WordPool::removeAt(const std::size_t pos) -> std::uint32_t {
+	const std::uint32_t id = ids[pos];
+	const std::uint32_t last = ids.back();
+	ids[pos] = last;
+	positions[last] = static_cast<std::uint32_t>(pos);
+	ids.pop_back();
+	positions[id] = absent;
+	if (!weights.empty()) {
+		addWeight(id, 0 - static_cast<std::uint64_t>(weights[id]));
+	}
+	return id;
+}
+
+auto WordPool::addWeight(const std::uint32_t id, const std::uint64_t delta) -> void {
+	totalWeight += delta;
+	for (std::size_t node = id + 1; node < tree.size(); node += node & (0 - node)) {
+		tree[node] += delta;
+	}
+}
+
+// Every node passes its sum on to its parent once, O(n)
+auto WordPool::rebuildTree() -> void {
+	tree.clear();
+	totalWeight = 0;
+	if (weights.empty()) {
+		return;
+	}
+	tree.assign(positions.size() + 1, 0);
+	for (std::size_t node = 1; node < tree.size(); ++node) {
+		if (positions[node - 1] != absent) {
+			tree[node] += weights[node - 1];
+			totalWeight += weights[node - 1];
+		}
+		if (const std::size_t parent = node + (node & (0 - node)); parent < tree.size()) {
+			tree[parent] += tree[node];
+		}
+	}
+}
+
+auto WordPool::contains(const std::uint32_t id) const -> bool {
+	return id < positions.size() && positions[id] != absent;
+}
+
+auto WordPool::size() const -> std::size_t {
+	return ids.size();
+}
+
+auto WordPool::empty() const -> bool {
+	return ids.empty();
+}
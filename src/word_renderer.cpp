@@ -0,0 +1,76 @@
+#include "word_renderer.h"
+#include "window.h"
+
+// constructor
+WordRenderer::WordRenderer(AssetRegistry &assets, const unsigned characterSize)
+	: assets(assets), characterSize(characterSize) {
+	batches.resize(assets.fontCount(), sf::VertexArray(sf::Triangles));
+}
+
+// Clearing keeps the capacity, so steady frames do not allocate
+auto WordRenderer::build(const FrameSnapshot &snapshot, const float alpha) -> void {
+	for (auto &batch : batches) {
+		batch.clear();
+	}
+	for (std::size_t i = 0; i < snapshot.size(); ++i) {
+		const int font = snapshot.fontIndex[i];
+		if (font < 0 || font >= static_cast<int>(batches.size())) {
+			continue;
+		}
+		appendWord(batches[font], assets.font(font).getSfFont(), snapshot.text[i],
+				   {snapshot.interpolatedX(i, alpha), snapshot.y[i]}, bandColor(snapshot.band[i]), snapshot.matched[i]);
+	}
+}
+
+auto WordRenderer::draw(sf::RenderTarget &target) const -> void {
+	for (std::size_t i = 0; i < batches.size(); ++i) {
+		if (batches[i].getVertexCount() == 0) {
+			continue;
+		}
+		const sf::Texture &atlas = assets.font(static_cast<FontHandle>(i)).getSfFont().getTexture(characterSize);
+		target.draw(batches[i], sf::RenderStates(&atlas));
+	}
+}
+
+// Same layout as sf::Text: baseline one character size below the position,
+// kerning between neighbours and one padded quad per visible glyph
+auto WordRenderer::appendWord(sf::VertexArray &batch, const sf::Font &font, const std::u32string_view word,
+							  const sf::Vector2f position, const sf::Color color, const std::size_t highlighted) const -> void {
+	constexpr float padding = 1.f;
+	float x = position.x;
+	const float y = position.y + static_cast<float>(characterSize);
+	sf::Uint32 prevChar = 0;
+
+	for (std::size_t i = 0; i < word.size(); ++i) {
+		const auto curChar = static_cast<sf::Uint32>(word[i]);
+		x += font.getKerning(prevChar, curChar, characterSize);
+		prevChar = curChar;
+
+		const sf::Glyph &glyph = font.getGlyph(curChar, characterSize, false);
+		if (curChar == ' ') {
+			x += glyph.advance;
+			continue;
+		}
+
+		const float left = x + glyph.bounds.left - padding;
+		const float top = y + glyph.bounds.top - padding;
+		const float right = x + glyph.bounds.left + glyph.bounds.width + padding;
+		const float bottom = y + glyph.bounds.top + glyph.bounds.height + padding;
+
+		const auto u1 = static_cast<float>(glyph.textureRect.left) - padding;
+		const auto v1 = static_cast<float>(glyph.textureRect.top) - padding;
+		const auto u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+		const auto v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+		// typed prefix is highlighted
+		const sf::Color glyphColor = i < highlighted ? sf::Color::White : color;
+		batch.append(sf::Vertex({left, top}, glyphColor, {u1, v1}));
+		batch.append(sf::Vertex({right, top}, glyphColor, {u2, v1}));
+		batch.append(sf::Vertex({left, bottom}, glyphColor, {u1, v2}));
+		batch.append(sf::Vertex({left, bottom}, glyphColor, {u1, v2}));
+		batch.append(sf::Vertex({right, top}, glyphColor, {u2, v1}));
+		batch.append(sf::Vertex({right, bottom}, glyphColor, {u2, v2}));
+
+		x += glyph.advance;
+	}
+}
@@ -0,0 +1,126 @@
+// Checks that weighted picks of WordPool follow the weights, also after
+// ids were taken and given back. Returns non zero when a check fails.
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "rng.h"
+#include "word_pool.h"
+
+namespace {
+
+int failures = 0;
+
+auto check(const bool ok, const char* what) -> void {
+	if (!ok) {
+		std::printf("FAILED: %s\n", what);
+		failures++;
+	}
+}
+
+// Zipf weights, the shape of real word frequencies
+auto zipf(const std::size_t count) -> std::vector<float> {
+	std::vector<float> weights(count);
+	for (std::size_t id = 0; id < count; ++id) {
+		weights[id] = 1.f / static_cast<float>(id + 1);
+	}
+	return weights;
+}
+
+// share of draws that hit ids 0..top-1, against the share their weights make up
+auto topShare(const std::size_t count, const std::size_t top, const int draws) -> void {
+	const std::vector<float> weights = zipf(count);
+	WordPool pool;
+	pool.reset(count);
+	pool.setWeights(weights);
+	RandomEngine gen(42);
+	int hits = 0;
+	for (int i = 0; i < draws; ++i) {
+		hits += pool.sample(gen) < top ? 1 : 0;
+	}
+	double topWeight = 0.0;
+	double totalWeight = 0.0;
+	for (std::size_t id = 0; id < count; ++id) {
+		totalWeight += weights[id];
+		topWeight += id < top ? weights[id] : 0.0;
+	}
+	const double expected = topWeight / totalWeight;
+	const double measured = static_cast<double>(hits) / draws;
+	// five standard deviations of a binomial share
+	const double tolerance = 5.0 * std::sqrt(expected * (1.0 - expected) / draws);
+	std::printf("count %zu: top %zu share %.4f, expected %.4f\n", count, top, measured, expected);
+	check(std::abs(measured - expected) < tolerance, "top ids are picked as often as their weight says");
+}
+
+// every id of a small pool is picked in proportion to its weight
+auto everyId() -> void {
+	const std::vector<float> weights = {1.f, 2.f, 0.f, 4.f, 8.f, 0.5f};
+	WordPool pool;
+	pool.reset(weights.size());
+	pool.setWeights(weights);
+	RandomEngine gen(7);
+	constexpr int draws = 1'000'000;
+	std::vector<int> hits(weights.size());
+	for (int i = 0; i < draws; ++i) {
+		hits[pool.sample(gen)]++;
+	}
+	check(hits[2] == 0, "an id of weight zero is never picked");
+	double chiSquare = 0.0;
+	for (std::size_t id = 0; id < weights.size(); ++id) {
+		const double expected = draws * weights[id] / 15.5;
+		if (expected > 0.0) {
+			chiSquare += (hits[id] - expected) * (hits[id] - expected) / expected;
+		}
+	}
+	// 4 degrees of freedom, p < 0.001 above 18.5
+	check(chiSquare < 18.5, "picks follow the weights");
+}
+
+// taken ids drop out of the weighted picks and come back when given back
+auto takeAndGive() -> void {
+	constexpr std::size_t count = 1000;
+	WordPool pool;
+	pool.reset(count);
+	pool.setWeights(zipf(count));
+	RandomEngine gen(3);
+	std::vector<std::uint32_t> taken;
+	for (int i = 0; i < 500; ++i) {
+		taken.push_back(pool.take(gen));
+	}
+	check(pool.size() == count - taken.size(), "take removes one id");
+	bool pickedTaken = false;
+	for (int i = 0; i < 100'000; ++i) {
+		pickedTaken = pickedTaken || !pool.contains(pool.sample(gen));
+	}
+	check(!pickedTaken, "taken ids are not picked");
+	for (const std::uint32_t id : taken) {
+		pool.give(id);
+	}
+	while (!pool.empty()) {
+		pool.take(gen);
+	}
+	check(pool.size() == 0, "every id can be taken once");
+	for (const std::uint32_t id : taken) {
+		pool.give(id);
+	}
+	// the pool holds only given back ids, picks still land on them
+	bool pickedOther = false;
+	for (int i = 0; i < 10'000; ++i) {
+		pickedOther = pickedOther || !pool.contains(pool.sample(gen));
+	}
+	check(!pickedOther, "picks stay within the given back ids");
+}
+
+} // namespace
+
+int main() {
+	topShare(10'000, 10, 1'000'000);
+	topShare(1'000'000, 10, 1'000'000);
+	everyId();
+	takeAndGive();
+	if (failures > 0) {
+		std::printf("word pool: %d checks failed\n", failures);
+		return 1;
+	}
+	std::printf("word pool: all checks passed\n");
+	return 0;
+}
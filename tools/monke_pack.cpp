@@ -0,0 +1,45 @@
+// Bundles the assets directory into one pack file loaded by the game.
+// Usage: monke_pack <assets directory> <output pack>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "asset_pack.h"
+
+int main(int argc, char* argv[]) {
+	if (argc != 3) {
+		std::cerr << "Usage: monke_pack <assets directory> <output pack>\n";
+		return 1;
+	}
+	namespace fs = std::filesystem;
+	const fs::path root = argv[1];
+
+	std::vector<std::pair<std::string, std::string>> files;
+	std::error_code ec;
+	for (const auto &entry : fs::recursive_directory_iterator(root, ec)) {
+		if (!entry.is_regular_file()) {
+			continue;
+		}
+		std::ifstream in(entry.path(), std::ios::binary);
+		std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		if (!in && !in.eof()) {
+			std::cerr << "Cannot read " << entry.path() << "\n";
+			return 1;
+		}
+		// pack names always use '/'
+		files.emplace_back(fs::relative(entry.path(), root).generic_string(), std::move(contents));
+	}
+	if (ec) {
+		std::cerr << "Cannot read assets directory " << root << ": " << ec.message() << "\n";
+		return 1;
+	}
+
+	if (!AssetPack::write(argv[2], std::move(files))) {
+		std::cerr << "Cannot write " << argv[2] << "\n";
+		return 1;
+	}
+	return 0;
+}